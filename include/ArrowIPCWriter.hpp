@@ -0,0 +1,134 @@
+/*!
+ * \file ArrowIPCWriter.hpp
+ * \brief Apache Arrow IPC Stream Output Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef ARROWIPCWRITER_HPP_
+#define ARROWIPCWRITER_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include <mongotype.hpp>
+#include <OutputSink.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class ArrowIPCWriter
+ * \brief Writes the messages of an Apache Arrow IPC stream: a schema, record batches, and the end of stream marker.
+ *
+ * Each message is the continuation marker, the length of its metadata, the metadata, i.e., a Message flatbuffer padded
+ * to a multiple of 8 bytes, then the message body, whose buffers each start at a multiple of 8 bytes. The flatbuffers are
+ * built by hand, front to back, so no Arrow or FlatBuffers library is required. Only the little endian, uncompressed,
+ * dictionary free subset of the format is written, with the metadata version V5.
+ *
+ * \see https://arrow.apache.org/docs/format/Columnar.html#serialization-and-interprocess-communication-ipc
+ */
+
+class ArrowIPCWriter {
+public:
+	/*!
+	 * \enum Type The field types written, valued as the flatbuffer Type union of Schema.fbs.
+	 */
+	enum Type {
+		NULL_TYPE = 1,			/*!< Every value is null, there are no buffers. */
+		INT = 2,				/*!< An integer of Field::width bits, signed if Field::isSigned. */
+		FLOATING_POINT = 3,		/*!< A 64 bit double. */
+		BINARY = 4,				/*!< Variable length bytes. */
+		UTF8 = 5,				/*!< Variable length UTF-8 text. */
+		BOOL = 6,				/*!< A bit per value. */
+		TIMESTAMP = 10,			/*!< A 64 bit count of milliseconds since the epoch, UTC. */
+		LIST = 12,				/*!< A variable length list of the one child field's values. */
+		STRUCT = 13,			/*!< A value of each child field. */
+		FIXED_SIZE_BINARY = 15	/*!< Field::width bytes. */
+	};
+
+	/*!
+	 * \brief A schema field, every field being nullable.
+	 */
+	struct Field {
+		string name;
+		Type type;
+		int width;				/*!< The bit width of an INT, or the byte width of a FIXED_SIZE_BINARY. */
+		bool isSigned;			/*!< True for a signed INT. */
+		vector<Field> children;	/*!< The fields of a STRUCT, or the single item field of a LIST. */
+		Field(const string& pname, Type ptype, int pwidth = 0, bool pisSigned = true) :
+			name(pname), type(ptype), width(pwidth), isSigned(pisSigned) {}
+	};
+
+	/*!
+	 * \brief The value and null counts of a field in a record batch, listed in schema field pre-order.
+	 */
+	struct FieldNode {
+		int64_t length;
+		int64_t nullCount;
+	};
+
+	/*!
+	 * \brief A buffer of a record batch: a validity bitmap, offsets, values, or data, listed in schema field pre-order.
+	 */
+	struct BodyBuffer {
+		const char* data;
+		size_t size;
+	};
+
+	/*!
+	 * \brief Write the Schema message, which precedes every record batch.
+	 * \param[in] sink The output sink.
+	 * \param[in] fields The top level fields, the columns of each record batch.
+	 */
+	static void writeSchema(OutputSink& sink, const vector<Field>& fields);
+
+	/*!
+	 * \brief Write a RecordBatch message.
+	 * \param[in] sink The output sink.
+	 * \param[in] length The count of rows.
+	 * \param[in] nodes A node per field.
+	 * \param[in] buffers The buffers of every field, each padded to 8 bytes in the body.
+	 */
+	static void writeRecordBatch(OutputSink& sink, int64_t length, const vector<FieldNode>& nodes, const vector<BodyBuffer>& buffers);
+
+	/*!
+	 * \brief Write the end of stream marker.
+	 * \param[in] sink The output sink.
+	 */
+	static void writeEndOfStream(OutputSink& sink);
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* ARROWIPCWRITER_HPP_ */
@@ -0,0 +1,253 @@
+/*!
+ * \file BSONArrowDump.hpp
+ * \brief BSON to Apache Arrow IPC Stream Dump Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef BSONARROWDUMP_HPP_
+#define BSONARROWDUMP_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <unordered_map>
+
+#include <mongotype.hpp>
+#include <Parameters.hpp>
+#include <IBSONRenderer.hpp>
+#include <BSONObjectParser.hpp>
+#include <ArrowIPCWriter.hpp>
+#include <ExtendedJSONWriter.hpp>
+#include <OutputSink.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class BSONArrowDump
+ * \brief BSON -> Apache Arrow IPC stream dump: a schema, then record batches built column by column.
+ *
+ * The schema is inferred from the first --sample documents, which are held until it is known, then parsed again by
+ * the dump's own parser, even as one of several --outputs, to append their rows: each key of the
+ * documents is a field, embedded objects being struct fields and arrays list fields of their merged element type.
+ * Each field's type follows the BSON type codes of its values:
+ *
+ * | BSON type                  | Arrow type                     |
+ * |----------------------------|--------------------------------|
+ * | NumberInt                  | int32                          |
+ * | NumberLong                 | int64, or with NumberInt       |
+ * | NumberDouble               | double, or with any integer    |
+ * | Bool                       | bool                           |
+ * | Date                       | timestamp[ms, tz=UTC]          |
+ * | Timestamp                  | uint64                         |
+ * | jstOID                     | fixed_size_binary[12]          |
+ * | BinData                    | binary                         |
+ * | Object, Array              | struct, list                   |
+ * | jstNULL, Undefined         | null, or with any other type   |
+ * | String and any other mix   | utf8                           |
+ *
+ * Values of other types, e.g., Decimal128 or RegEx, and values of a field given mixed types, are the field's utf8
+ * text in relaxed Extended JSON, or the text of a string. Keys missing from a document, values that do not fit their
+ * field's type, and objects and arrays summarized per --max-depth are null. Keys absent from the sample are not output.
+ * Of the values of a key repeated within an object, only the first is output. Objects and arrays nested deeper than
+ * MAX_NESTING are utf8 text.
+ *
+ * A record batch is written every ROWS_PER_BATCH documents, or sooner once its buffers hold BYTES_PER_BATCH bytes.
+ *
+ * \see ArrowIPCWriter, IBSONObjectVisitor, BSONObjectParser
+ */
+
+class BSONArrowDump : virtual public IBSONRenderer, virtual protected IBSONObjectVisitor {
+public:
+	/*!
+	 * The count of rows after which a record batch is written.
+	 */
+	static const int64_t ROWS_PER_BATCH = 65536;
+
+	/*!
+	 * The count of buffered value bytes after which a record batch is written, keeping the 32 bit offsets in range.
+	 */
+	static const size_t BYTES_PER_BATCH = 64 * 1024 * 1024;
+
+	/*!
+	 * The deepest nesting of struct and list fields, deeper objects and arrays being utf8 text, within the nesting
+	 * readers verify the schema to.
+	 */
+	static const size_t MAX_NESTING = 32;
+
+private:
+	/*!
+	 * \enum Kind The Arrow type of a column, see the class description.
+	 */
+	enum Kind { NONE, INT32, INT64, UINT64, DOUBLE, BOOL, DATE, OBJECT_ID, BINARY, UTF8, LIST, STRUCT };
+
+	/*!
+	 * \brief A field of the schema and the buffers of its values in the record batch being built.
+	 */
+	struct Column {
+		string name;
+		Kind kind;
+		vector<unique_ptr<Column>> children;	/*!< The fields of a STRUCT in order first seen, or a LIST's item. */
+		unordered_map<string, size_t> childIndex;	/*!< The index in \ref children of each STRUCT field name. */
+
+		int64_t length;
+		int64_t nullCount;
+		string validity;	/*!< A bit per value, set if the value is not null. */
+		string values;		/*!< The fixed width values, or a bit per BOOL value. */
+		string offsets;		/*!< The int32 offsets of the UTF8 or BINARY values in \ref data, or of the LIST items. */
+		string data;		/*!< The UTF8 or BINARY bytes. */
+
+		Column(const string& pname, Kind pkind) : name(pname), kind(pkind), length(0), nullCount(0) {
+			reset();
+		}
+
+		Column* child(StringData key, bool create);
+		void setKind(Kind pkind);
+		void reset();
+		void appendValidity(bool valid);
+		void appendOffset(int32_t offset);
+		void appendNull();
+		void appendFixed(const void* p, size_t n);
+		void appendBool(bool value);
+		void appendBytes(const char* p, size_t n);
+		void fillChildren();
+		void endList();
+		ArrowIPCWriter::Field toField() const;
+		void collect(vector<ArrowIPCWriter::FieldNode>& nodes, vector<ArrowIPCWriter::BodyBuffer>& buffers) const;
+	};
+
+	Parameters& params;
+	BSONLazyObjectParser objectParser; // Parses every rendered document, reusing its buffers.
+	OutputSink* out; // The sink written to, see setOutputSink().
+
+	Column root;				/*!< The document, whose children are the record batch columns. */
+	vector<Column*> open;		/*!< The document and the struct and list columns enclosing the parse position. */
+	int skipDepth;				/*!< The nesting depth within an object or array that has no column, zero if none. */
+	size_t batchBytes;			/*!< The count of value bytes buffered in the record batch being built. */
+	bool sampling;				/*!< True while the schema is inferred from the sampled documents. */
+	vector<BSONObj> samples;	/*!< The sampled documents, owned, rendered once the schema is known. */
+	ExtendedJSONWriter textWriter;	/*!< Writes the utf8 text of values of other types, in relaxed Extended JSON. */
+	OutputSink text;			/*!< The text of one value. */
+
+	static Kind kindOf(int type);
+	static Kind merge(Kind a, Kind b);
+
+	Column* target(const BSONParserStack& stack, Kind kind);
+	void startNested(const BSONParserStack& stack, Kind kind);
+	void endNested();
+	void appendValue(Column& column, const BSONElement& element);
+	void appendText(Column& column, const BSONObj& object, bool isArray);
+	void endSampling();
+	void writeBatch();
+
+protected: // IBSONObjectVisitor overrides.
+
+	virtual void onParseStart() { }
+
+	virtual void onParseEnd() { }
+
+	virtual void onObjectStart(const BSONParserStack& stack);
+
+	virtual void onObjectEnd(const BSONParserStack& stack);
+
+	virtual void onArrayStart(const BSONParserStack& stack) {
+		startNested(stack, LIST);
+	}
+
+	virtual void onArrayEnd(const BSONParserStack& stack) {
+		endNested();
+	}
+
+	virtual void onElement(const BSONParserStack& stack);
+
+	virtual void onElided(const BSONParserStack& stack, const BSONElision& elision);
+
+	virtual bool isArrayCountRequired() const {
+		return false; // The array count is never output.
+	}
+
+public: // User Interface
+
+	/*!
+	 * \brief Construct a BSON Arrow dumper.
+	 * \param[in] pparams The command line parameters object, giving the --sample count.
+	 */
+	BSONArrowDump(Parameters& pparams);
+
+	virtual ~BSONArrowDump() {};
+
+	/*
+	 * \param[in] sink The output sink to which the object(s) are rendered.
+	 */
+	virtual void setOutputSink(OutputSink& sink) {
+		out = &sink;
+	}
+
+	/*
+	 * \param[in] prefix Unused, the schema is written once the documents are sampled.
+	 */
+	virtual void begin(const char* prefix) {
+	}
+
+	/*
+	 * \param[in] suffix Unused, the stream ends with the last record batch and the end of stream marker.
+	 */
+	virtual void end(const char* suffix);
+
+	virtual void render(const BSONObj& object, int docIndex, int docCount) {
+		beginDocument(docIndex, docCount);
+		objectParser.parse(object); // Infer the document's types, or append its row.
+	}
+
+	virtual void renderBatch(const BSONObj* objects, int count, int firstIndex, int docCount) {
+		renderEach(*this, objects, count, firstIndex, docCount);
+		flush();
+	}
+
+	virtual void flush() {
+		out->flush();
+	}
+
+	virtual void beginDocument(int docIndex, int docCount) {
+		if (sampling && (int)samples.size() >= params.getSampleSize()) {
+			endSampling();
+		}
+	}
+
+	virtual IBSONObjectVisitor& getVisitor() {
+		return *this;
+	}
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* BSONARROWDUMP_HPP_ */
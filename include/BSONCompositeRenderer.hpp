@@ -0,0 +1,182 @@
+/*!
+ * \file BSONCompositeRenderer.hpp
+ * \brief Fan-out of one BSON parse to several visitors and renderers
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef BSONCOMPOSITERENDERER_HPP_
+#define BSONCOMPOSITERENDERER_HPP_
+
+#include <mongotype.hpp>
+#include <Parameters.hpp>
+#include <IBSONRenderer.hpp>
+#include <BSONObjectParser.hpp>
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \brief Composite visitor dispatching every parse event to each of several visitors in turn.
+ *
+ * \see IBSONObjectVisitor, BSONObjectParser
+ */
+
+class BSONCompositeVisitor : virtual public IBSONObjectVisitor {
+	vector<IBSONObjectVisitor*> visitors;
+	bool arrayCountRequired;
+
+public:
+	BSONCompositeVisitor() : arrayCountRequired(false) {}
+	virtual ~BSONCompositeVisitor() {}
+
+	/*!
+	 * \brief Add a visitor to receive the parse events.
+	 * \param[in] visitor The visitor. Ownership is not taken, the visitor must outlive the composite.
+	 */
+	void add(IBSONObjectVisitor& visitor) {
+		visitors.push_back(&visitor);
+		arrayCountRequired = arrayCountRequired || visitor.isArrayCountRequired();
+	}
+
+	virtual void onParseStart() {
+		for (IBSONObjectVisitor* v : visitors) v->onParseStart();
+	}
+
+	virtual void onParseEnd() {
+		for (IBSONObjectVisitor* v : visitors) v->onParseEnd();
+	}
+
+	virtual void onObjectStart(const BSONParserStack& stack) {
+		for (IBSONObjectVisitor* v : visitors) v->onObjectStart(stack);
+	}
+
+	virtual void onObjectEnd(const BSONParserStack& stack) {
+		for (IBSONObjectVisitor* v : visitors) v->onObjectEnd(stack);
+	}
+
+	virtual void onArrayStart(const BSONParserStack& stack) {
+		for (IBSONObjectVisitor* v : visitors) v->onArrayStart(stack);
+	}
+
+	virtual void onArrayEnd(const BSONParserStack& stack) {
+		for (IBSONObjectVisitor* v : visitors) v->onArrayEnd(stack);
+	}
+
+	virtual void onElement(const BSONParserStack& stack) {
+		for (IBSONObjectVisitor* v : visitors) v->onElement(stack);
+	}
+
+	virtual void onElided(const BSONParserStack& stack, const BSONElision& elision) {
+		for (IBSONObjectVisitor* v : visitors) v->onElided(stack, elision);
+	}
+
+	virtual bool isArrayCountRequired() const {
+		return arrayCountRequired;
+	}
+};
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \brief Renders each document in several styles from a single parse.
+ *
+ * Each contained renderer writes to its own output sink. Every document is parsed once and the parse
+ * events are fanned out to all the renderers through a BSONCompositeVisitor. The contained renderers do not
+ * parse, so they do not construct their own BSONLazyObjectParser's parser, with one exception: BSONArrowDump
+ * holds its --sample documents until their schema is known, then parses them a second time with its own parser to
+ * append their rows, as the values of a column cannot be encoded before its type is inferred.
+ *
+ * \see IBSONRenderer, BSONCompositeVisitor
+ */
+
+class BSONCompositeRenderer : virtual public IBSONRenderer {
+	vector<unique_ptr<OutputSink>> sinks; // Declared before renderers so the sinks are destroyed last.
+	vector<unique_ptr<IBSONRenderer>> renderers;
+	BSONCompositeVisitor visitor;
+	BSONObjectParser objectParser; // One parse feeds every renderer.
+
+public:
+	/*!
+	 * \param[in] pparams The command line parameters object.
+	 */
+	BSONCompositeRenderer(Parameters& pparams) : objectParser(visitor, pparams) {}
+
+	virtual ~BSONCompositeRenderer() {}
+
+	/*!
+	 * \brief Add a renderer writing to the given output sink.
+	 * \param[in] renderer The renderer, ownership is taken.
+	 * \param[in] sink The output sink the renderer writes to, ownership is taken. Sinks are never shared: the
+	 * renderers receive each event in turn, so renderers sharing a file would interleave their output token by token.
+	 */
+	void add(IBSONRenderer* renderer, OutputSink* sink) {
+		sinks.push_back(unique_ptr<OutputSink>(sink));
+		renderer->setOutputSink(*sink);
+		renderers.push_back(unique_ptr<IBSONRenderer>(renderer));
+		visitor.add(renderer->getVisitor());
+	}
+
+	/*
+	 * \param[in] sink Ignored: each contained renderer has its own output sink. See add().
+	 */
+	virtual void setOutputSink(OutputSink& sink) {}
+
+	virtual void begin(const char* prefix) {
+		for (unique_ptr<IBSONRenderer>& r : renderers) r->begin(prefix);
+	}
+
+	virtual void end(const char* suffix) {
+		for (unique_ptr<IBSONRenderer>& r : renderers) r->end(suffix);
+	}
+
+	virtual void render(const BSONObj& object, int docIndex, int docCount) {
+		beginDocument(docIndex, docCount);
+		objectParser.parse(object);
+	}
+
+	virtual void renderBatch(const BSONObj* objects, int count, int firstIndex, int docCount) {
+		renderEach(*this, objects, count, firstIndex, docCount);
+		flush();
+	}
+
+	virtual void flush() {
+		for (unique_ptr<IBSONRenderer>& r : renderers) r->flush();
+	}
+
+	virtual void beginDocument(int docIndex, int docCount) {
+		for (unique_ptr<IBSONRenderer>& r : renderers) r->beginDocument(docIndex, docCount);
+	}
+
+	virtual IBSONObjectVisitor& getVisitor() {
+		return visitor;
+	}
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+#endif /* BSONCOMPOSITERENDERER_HPP_ */
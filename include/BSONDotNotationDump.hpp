@@ -30,28 +30,70 @@
 #ifndef BSONDOTNOTATIONDUMP_HPP_
 #define BSONDOTNOTATIONDUMP_HPP_
 
+#include <unordered_map>
+
 #include <mongotype.hpp>
 #include <Parameters.hpp>
 #include <IBSONRenderer.hpp>
 #include <BSONTypeFormatter.hpp>
 #include <BSONObjectParser.hpp>
+#include <BSONShape.hpp>
+#include <BSONValueWriter.hpp>
+#include <BSONDotPath.hpp>
 
 namespace mongotype {
 
 /*!
  * \brief Human readable BSON Object Dump
  *
- * Provides an std::ostream comparable output operator for dumping a human readable text
+ * Provides an output operator for dumping a human readable text
  * version of the given BSON object. BSONObjectTypeDump implements interface IBSONObjectVisitor and
  * uses the BSON object parsing events to output the BSON object's text representation.
  *
+ * Each output line is a dotted path, the element's key and value, and its type string. All but the value are fixed
+ * for a given BSONShape, so the first document of each shape records them in a render plan and later documents of
+ * that shape only format their values.
+ *
  * \see IBSONObjectVisitor, BSONObjectParser
  */
 
 class BSONDotNotationDump : virtual public IBSONRenderer, virtual protected IBSONObjectVisitor {
 	Parameters& params;
-	deque<string> dotStack;
-	function<ostream&()> getOStream; // std::function required to store a closure.
+	BSONDotPath path;	/*!< The dotted path of the innermost array or array element object, e.g., "db.c.a[2].b". */
+	BSONTypeFormatCache typeStrings;
+	BSONLazyObjectParser objectParser; // Parses every rendered document, reusing its buffers.
+	OutputSink* out; // The sink written to, see setOutputSink().
+
+	/*!
+	 * \brief The value independent text of one output line.
+	 */
+	struct PlanLine {
+		BSONType type;	/*!< The element type, verified on replay. */
+		string key;		/*!< The element key, verified on replay. */
+		string prefix;	/*!< The dotted path, key and ": " preceding the value. The path is verified on replay. */
+		size_t pathLength;	/*!< The length of the dotted path at the start of \ref prefix. */
+		string suffix;	/*!< The type string and newline following the value. */
+	};
+
+	/*!
+	 * \brief The output lines of one document shape in parse order.
+	 */
+	struct Plan {
+		vector<PlanLine> lines;
+		bool complete;
+		bool split;	/*!< True if the shape has an array split between threads, whose lines are output by fork()s, so it is never planned. */
+		Plan() : complete(false), split(false) {}
+	};
+
+	/*!
+	 * The number of shapes planned, further shapes are rendered without a plan.
+	 */
+	static const size_t MAX_PLANS = 256;
+
+	unordered_map<uint64_t, Plan> plans;
+	Plan* plan;			/*!< The plan of the document being rendered, or NULL if there is none. */
+	bool recording;		/*!< True if \ref plan is being recorded, false if it is being replayed. */
+	size_t planLine;	/*!< The index of the next line of \ref plan to replay. */
 
 protected: // IBSONObjectVisitor overrides.
 
@@ -61,41 +103,114 @@ protected: // IBSONObjectVisitor overrides.
 
 	virtual void onObjectStart(const BSONParserStack& stack) {
 		if (stack.top().getArrayIndex() >= 0) { // If the object is an element of an array...
-			 string s("[");
-			 s += to_string(stack.top().getArrayIndex());
-			 s += "]"; // Output an array index first.
-			 dotStack.push_back(s);
+			path.push(); // Output an array index first.
+			path += '[';
+			path.appendIndex(stack.top().getArrayIndex());
+			path += ']';
 		}
 	}
 
 	virtual void onObjectEnd(const BSONParserStack& stack) {
 		if (stack.top().getArrayIndex() >= 0) { // If the object is an element of an array...
-			dotStack.pop_back();
+			path.pop();
 		}
 	}
 
 	virtual void onArrayStart(const BSONParserStack& stack) {
-		string s(".");
-		s += stack.top().getArray().fieldName();
-		 dotStack.push_back(s);
+		path.push();
+		path += '.';
+		path += stack.top().getArray().fieldNameStringData();
 	}
 
 	virtual void onArrayEnd(const BSONParserStack& stack) {
-		dotStack.pop_back();
+		path.pop();
 	}
 
 	virtual void onElement(const BSONParserStack& stack) {
 		const BSONElement& element = stack.top().getElement();
-		BSONTypeFormatter type(params, element);
-		string acc;
-		for (string s: dotStack) {
-			acc += s;
+		if (plan != NULL && !recording) {
+			if (planLine < plan->lines.size()) {
+				const PlanLine& line = plan->lines[planLine];
+				const string& p = path.str();
+				// The full line is verified, as documents of different shapes may share a fingerprint.
+				if (line.type == element.type() && element.fieldNameStringData() == StringData(line.key)
+						&& line.pathLength == p.size() && line.prefix.compare(0, p.size(), p) == 0) {
+					planLine++;
+					*out << line.prefix;
+					BSONValueWriter::writeAbbreviated(*out, element, false);
+					*out << line.suffix;
+					return;
+				}
+			}
+			plan = NULL; // A fingerprint collision, build the remaining lines.
+		}
+		if (!recording) { // Output the path, leaf key, value and type string directly.
+			*out << path.str() << '.';
+			if (!element.eoo()) {
+				*out << element.fieldNameStringData() << ": ";
+			}
+			BSONValueWriter::writeAbbreviated(*out, element, false);
+			*out << ' ' << typeStrings.get(element) << '\n';
+			return;
 		}
+		PlanLine line;
+		line.prefix = path.str();
+		line.pathLength = line.prefix.size();
+		line.prefix += '.';
+		if (!element.eoo()) {
+			line.prefix += element.fieldName();
+			line.prefix += ": ";
+		}
+		line.suffix = " ";
+		line.suffix += typeStrings.get(element);
+		line.suffix += "\n";
+		*out << line.prefix;
+		BSONValueWriter::writeAbbreviated(*out, element, false);
+		*out << line.suffix;
+		line.type = element.type();
+		line.key = element.fieldName();
+		plan->lines.push_back(line);
+	}
+
+	virtual void onElided(const BSONParserStack& stack, const BSONElision& elision) {
+		string acc(path.str());
 		acc += '.';
-		acc += string(element);
-		acc += " ";
-		acc += type.to_string();
-		getOStream() << acc << "\n";
+		if (elision.kind == BSONElision::DEPTH) { // The object or array's path, key and type like an element.
+			const BSONElement& element = stack.top().getElement();
+			acc += element.fieldName();
+			acc += ": ";
+			acc += elision.summary();
+			acc += " ";
+			acc += typeStrings.get(element);
+		} else { // The range of array indexes omitted.
+			acc += to_string(elision.index);
+			acc += "-";
+			acc += to_string(elision.index + elision.count - 1);
+			acc += ": ";
+			acc += elision.summary();
+		}
+		*out << acc << "\n";
+	}
+
+	virtual bool isArrayCountRequired() const {
+		return false; // The array count is never output.
+	}
+
+	virtual IBSONObjectVisitor* fork(OutputSink& fragment) {
+		if (recording) {
+			plan->split = true;
+			recording = false;
+		}
+		plan = NULL; // The forks output lines of the plan, build the remaining lines.
+		string initialToken(path.root());
+		BSONDotNotationDump* forked = new BSONDotNotationDump(params, initialToken);
+		forked->path = path;
+		forked->setOutputSink(fragment);
+		return forked;
+	}
+
+	virtual void join(const OutputSink& fragment) {
+		*out << fragment;
 	}
 
 public: // User Interface
@@ -106,18 +221,16 @@ public: // User Interface
 	 * \param[in] initialToken The string used to indent the text output. The indent text is prepended to the output lines once for each indent level.
 	 */
 	BSONDotNotationDump(Parameters& pparams, string& initialToken) :
-		params(pparams) {
-		dotStack.clear();
-		dotStack.push_back(initialToken);
+		params(pparams), path(initialToken), typeStrings(pparams), objectParser(*this, pparams), out(NULL), plan(NULL), recording(false), planLine(0) {
 	};
 
 	virtual ~BSONDotNotationDump() {};
 
 	/*
-	 * \param[in] os The output stream to which the object(s) are rendered.
+	 * \param[in] sink The output sink to which the object(s) are rendered.
 	 */
-	virtual void setOutputStream(std::ostream& os) {
-		getOStream = [&] () -> ostream& { return os; }; // Wrap closure around ostream.
+	virtual void setOutputSink(OutputSink& sink) {
+		out = &sink;
 	}
 
 	/*
@@ -125,7 +238,7 @@ public: // User Interface
 	 */
 	virtual void begin(const char* prefix) {
 		if (prefix != NULL) {
-			getOStream() << prefix;
+			*out << prefix;
 		}
 	}
 
@@ -134,14 +247,58 @@ public: // User Interface
 	 */
 	virtual void end(const char* suffix) {
 		if (suffix != NULL) {
-			getOStream() << suffix;
+			*out << suffix;
 		}
 	}
 
 	virtual void render(const BSONObj& object, int docIndex, int docCount) {
-		getOStream() << "\n";
-		BSONObjectParser objectParser(*this); // Construct a parser around this event handler.
+		beginDocument(docIndex, docCount);
+		selectPlan(object);
 		objectParser.parse(object);     // Parse the object and write the text output the the output stream.
+		if (recording) {
+			plan->complete = true;
+		}
+	}
+
+	/*!
+	 * \brief Select the render plan of the document's shape, or start recording one.
+	 * \param[in] object The document about to be parsed.
+	 */
+	void selectPlan(const BSONObj& object) {
+		uint64_t shape = BSONShape::fingerprint(object);
+		unordered_map<uint64_t, Plan>::iterator i = plans.find(shape);
+		if (i != plans.end() && i->second.split) {
+			plan = NULL;
+			recording = false;
+		} else if (i != plans.end() && i->second.complete) {
+			plan = &i->second;
+			recording = false;
+		} else if (i != plans.end() || plans.size() < MAX_PLANS) {
+			plan = &plans[shape];
+			plan->lines.clear();
+			recording = true;
+		} else {
+			plan = NULL;
+			recording = false;
+		}
+		planLine = 0;
+	}
+
+	virtual void renderBatch(const BSONObj* objects, int count, int firstIndex, int docCount) {
+		renderEach(*this, objects, count, firstIndex, docCount);
+		flush();
+	}
+
+	virtual void flush() {
+		out->flush();
+	}
+
+	virtual void beginDocument(int docIndex, int docCount) {
+		*out << "\n";
+	}
+
+	virtual IBSONObjectVisitor& getVisitor() {
+		return *this;
 	}
 };
 
@@ -0,0 +1,129 @@
+/*!
+ * \file BSONDotPath.hpp
+ * \brief Incrementally Built Dotted Path Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef BSONDOTPATH_HPP_
+#define BSONDOTPATH_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <mongotype.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class BSONDotPath
+ * \brief A dotted path built in one buffer as the parser descends and truncated as it returns.
+ *
+ * Each push() marks the path's length before the caller appends a component, and the matching pop() truncates the
+ * path back to the mark, so no component is copied more than once per visit and nothing is allocated once the
+ * buffer has grown to the deepest path.
+ */
+
+class BSONDotPath {
+	string path;
+	vector<size_t> marks;	/*!< The length of \ref path before each push(), restored by pop(). */
+
+public:
+	/*!
+	 * \param[in] root The text preceding every component, e.g., "db.c", or empty.
+	 */
+	BSONDotPath(const string& root = string()) : path(root) {}
+
+	/*!
+	 * \brief Start a path component, appended by the caller.
+	 */
+	void push() {
+		marks.push_back(path.size());
+	}
+
+	/*!
+	 * \brief Remove the last path component.
+	 */
+	void pop() {
+		path.resize(marks.back());
+		marks.pop_back();
+	}
+
+	BSONDotPath& operator+=(char c) {
+		path += c;
+		return *this;
+	}
+
+	BSONDotPath& operator+=(StringData s) {
+		path.append(s.rawData(), s.size());
+		return *this;
+	}
+
+	/*!
+	 * \brief Append an array index in decimal.
+	 */
+	void appendIndex(int index) {
+		char digits[12];
+		char* end = digits + sizeof(digits);
+		char* p = end;
+		do {
+			*--p = (char) ('0' + index % 10);
+			index /= 10;
+		} while (index > 0);
+		path.append(p, end - p);
+	}
+
+	/*!
+	 * \return The path text.
+	 */
+	const string& str() const {
+		return path;
+	}
+
+	/*!
+	 * \return True if no component has been appended to the root.
+	 */
+	bool isRoot() const {
+		return marks.empty();
+	}
+
+	/*!
+	 * \return The root text, preceding the first pushed component.
+	 */
+	string root() const {
+		return string(path, 0, marks.empty() ? path.size() : marks.front());
+	}
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* BSONDOTPATH_HPP_ */
@@ -0,0 +1,276 @@
+/*!
+ * \file BSONEventTape.hpp
+ * \brief BSON Parse Event Tape Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef BSONEVENTTAPE_HPP_
+#define BSONEVENTTAPE_HPP_
+
+#include <stdint.h>
+
+#include <mongotype.hpp>
+#include <Parameters.hpp>
+#include <BSONObjectParser.hpp>
+#include <BSONParseCursor.hpp>
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class BSONEventTape
+ * \brief The parse events of one document recorded as a contiguous array of fixed size entries.
+ *
+ * A BSONEventTape::Builder parses a document once with BSONObjectParser, honouring the same parse options as the
+ * renderers, and records each event as an \ref Entry holding the event, the nesting depth, the offset of the BSON
+ * element within the document, and the BSONParserStackItem indexes and counts. An IBSONTapeRenderer then walks the
+ * entries linearly, so the parse and the rendering of a document may run on different threads. See BSONParallelRenderer.
+ *
+ * The tape references the document's bytes, the document must outlive the tape's use.
+ *
+ * \see BSONObjectParser, BSONParseCursor::Event, IBSONTapeRenderer
+ */
+
+class BSONEventTape {
+public:
+	/*!
+	 * \brief One recorded parse event.
+	 */
+	struct Entry {
+		uint8_t event;			/*!< The BSONParseCursor::Event: OBJECT_START, OBJECT_END, ARRAY_START, ARRAY_END, ELEMENT or ELIDED. */
+		uint8_t inArray;		/*!< 1 if the object, array or element is an array element, else 0. */
+		uint16_t depth;			/*!< The BSONParserStack depth of the event, 1 for the document itself. */
+		uint32_t offset;		/*!< Offset of the BSON element within the document, 0 for the document itself. */
+		uint32_t link;			/*!< Index of the matching start or end entry, of the BSONElision for ELIDED, else 0. */
+		int32_t elementIndex;	/*!< See BSONParserStackItem::getElementIndex(). */
+		int32_t elementCount;	/*!< See BSONParserStackItem::getElementCount(). */
+		int32_t arrayIndex;		/*!< See BSONParserStackItem::getArrayIndex(). */
+		int32_t arrayCount;		/*!< See BSONParserStackItem::getArrayCount(). */
+	};
+
+	class Builder;
+
+private:
+	BSONObj document;
+	vector<Entry> entries;
+	vector<BSONElision> elisions;
+
+public:
+	BSONEventTape() {}
+	virtual ~BSONEventTape() {}
+
+	/*!
+	 * \brief Release the document and empty the tape, keeping the entry storage for the next document.
+	 */
+	void clear() {
+		document = BSONObj();
+		entries.clear();
+		elisions.clear();
+	}
+
+	/*!
+	 * \brief Release the document and empty the tape, and release the storage of a tape grown beyond a size.
+	 * \param[in] bytes The largest entry storage retained, e.g., --bufsize.
+	 */
+	void trim(size_t bytes) {
+		clear();
+		if (entries.capacity() * sizeof(Entry) > bytes) {
+			vector<Entry>().swap(entries);
+		}
+	}
+
+	/*!
+	 * \return The count of entries.
+	 */
+	size_t size() const {
+		return entries.size();
+	}
+
+	/*!
+	 * \param[in] i The entry index.
+	 * \return The entry.
+	 */
+	const Entry& entry(size_t i) const {
+		return entries[i];
+	}
+
+	/*!
+	 * \return The document the tape was built from.
+	 */
+	const BSONObj& getDocument() const {
+		return document;
+	}
+
+	/*!
+	 * \param[in] i The entry index of an entry below the document itself, i.e., of depth greater than 1.
+	 * \return The BSON element of the object, array or scalar.
+	 */
+	BSONElement element(size_t i) const {
+		return BSONElement(document.objdata() + entries[i].offset);
+	}
+
+	/*!
+	 * \param[in] i The entry index.
+	 * \return The key of the entry's object, array or element, empty for the document itself.
+	 */
+	StringData key(size_t i) const {
+		return entries[i].depth > 1 ? element(i).fieldNameStringData() : StringData();
+	}
+
+	/*!
+	 * \param[in] i The entry index of an OBJECT_START or OBJECT_END entry.
+	 * \return The BSON object.
+	 */
+	BSONObj object(size_t i) const {
+		return entries[i].depth > 1 ? element(i).embeddedObject() : document;
+	}
+
+	/*!
+	 * \param[in] i The entry index of an ELIDED entry.
+	 * \return The summary of the omitted elements.
+	 */
+	const BSONElision& elision(size_t i) const {
+		return elisions[entries[i].link];
+	}
+};
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class BSONEventTape::Builder
+ * \brief Records the parse events of documents onto tapes, reusing one parser and its buffers.
+ */
+
+class BSONEventTape::Builder : virtual protected IBSONObjectVisitor {
+	BSONEventTape* tape;
+	vector<uint32_t> open; // Indexes of the start entries awaiting their end entries.
+	bool arrayCountRequired;
+	BSONObjectParser parser;
+
+	Entry& record(BSONParseCursor::Event event, const BSONParserStack& stack) {
+		const BSONParserStackItem& top = stack.top();
+		const char* base = tape->document.objdata();
+		Entry e;
+		e.event = event;
+		e.inArray = stack.depth() > 1 && stack.item(-2).getType() == BSONParserStackItem::ARRAY;
+		e.depth = stack.depth();
+		e.link = 0;
+		e.elementIndex = top.getElementIndex();
+		e.elementCount = top.getElementCount();
+		e.arrayIndex = top.getArrayIndex();
+		e.arrayCount = top.getArrayCount();
+		if (top.getType() == BSONParserStackItem::OBJECT) { // The key is the field name of the embedded object's element.
+			e.offset = stack.depth() > 1 ? top.getKey().rawData() - 1 - base : 0;
+		} else {
+			const BSONElement& element = top.getType() == BSONParserStackItem::ARRAY ? top.getArray() : top.getElement();
+			e.offset = element.rawdata() - base;
+		}
+		tape->entries.push_back(e);
+		return tape->entries.back();
+	}
+
+	void recordStart(BSONParseCursor::Event event, const BSONParserStack& stack) {
+		open.push_back(tape->entries.size());
+		record(event, stack);
+	}
+
+	void recordEnd(BSONParseCursor::Event event, const BSONParserStack& stack) {
+		uint32_t start = open.back();
+		open.pop_back();
+		record(event, stack).link = start;
+		tape->entries[start].link = tape->entries.size() - 1;
+	}
+
+protected: // IBSONObjectVisitor overrides. ---------------------------------------------------------------------------
+
+	virtual void onParseStart() { open.clear(); }
+	virtual void onParseEnd() {}
+	virtual void onObjectStart(const BSONParserStack& stack) { recordStart(BSONParseCursor::OBJECT_START, stack); }
+	virtual void onObjectEnd(const BSONParserStack& stack) { recordEnd(BSONParseCursor::OBJECT_END, stack); }
+	virtual void onArrayStart(const BSONParserStack& stack) { recordStart(BSONParseCursor::ARRAY_START, stack); }
+	virtual void onArrayEnd(const BSONParserStack& stack) { recordEnd(BSONParseCursor::ARRAY_END, stack); }
+	virtual void onElement(const BSONParserStack& stack) { record(BSONParseCursor::ELEMENT, stack); }
+
+	virtual void onElided(const BSONParserStack& stack, const BSONElision& elision) {
+		record(BSONParseCursor::ELIDED, stack).link = tape->elisions.size();
+		tape->elisions.push_back(elision);
+	}
+
+	virtual bool isArrayCountRequired() const {
+		return arrayCountRequired;
+	}
+
+public:
+	/*!
+	 * \param[in] params The command line parameters supplying the parse options. See BSONObjectParser::BSONObjectParser(IBSONObjectVisitor&, const Parameters&).
+	 * \param[in] parrayCountRequired True to record the array counts, see IBSONObjectVisitor::isArrayCountRequired(). Given
+	 * by the visitor of the renderer reading the tapes.
+	 *
+	 * Arrays are never split, as the builder does not fork().
+	 */
+	Builder(const Parameters& params, bool parrayCountRequired) : tape(NULL), arrayCountRequired(parrayCountRequired), parser(*this, params) {}
+	virtual ~Builder() {}
+
+	/*!
+	 * \brief Parse a document onto a tape, replacing the tape's contents.
+	 * \param[in] object The document, referenced by the tape.
+	 * \param[out] ptape The tape.
+	 */
+	void build(const BSONObj& object, BSONEventTape& ptape) {
+		tape = &ptape;
+		tape->clear();
+		tape->document = object;
+		parser.parse(object);
+	}
+};
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \interface IBSONTapeRenderer
+ * \brief Implemented by renderers that render a document from its BSONEventTape as well as from the parse events.
+ *
+ * A renderer's tape output of a document is byte-identical to its IBSONRenderer::render() output.
+ */
+
+class IBSONTapeRenderer {
+public:
+	virtual ~IBSONTapeRenderer() {}
+
+	/*!
+	 * \brief Render a document from its tape, as IBSONRenderer::render() would.
+	 * \param[in] tape The tape of the document, built with the parse options of the renderer's own parser.
+	 * \param[in] docIndex The zero based index of the document.
+	 * \param[in] docCount The count of documents.
+	 */
+	virtual void renderTape(const BSONEventTape& tape, int docIndex, int docCount) = 0;
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+#endif /* BSONEVENTTAPE_HPP_ */
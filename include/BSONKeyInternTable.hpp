@@ -0,0 +1,121 @@
+/*!
+ * \file BSONKeyInternTable.hpp
+ * \brief BSON Key Intern Table Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef BSONKEYINTERNTABLE_HPP_
+#define BSONKEYINTERNTABLE_HPP_
+
+#include <unordered_map>
+
+#include <mongotype.hpp>
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class BSONKeyInternTable
+ * \brief Maps BSON key names to small integer ids.
+ *
+ * The same key names repeat in every document of a collection, so a table that lives for the whole run
+ * allows visitors to compare and hash keys by id instead of by string. A key is copied into the table
+ * only the first time it is seen; lookups of known keys do not allocate.
+ *
+ * \see BSONObjectParser::setKeyInternTable, BSONParserStackItem::getKeyId
+ */
+
+class BSONKeyInternTable {
+public:
+	/*!
+	 * The key id reported when no intern table is in use.
+	 */
+	static const int NO_ID = -1;
+
+private:
+	/*!
+	 * FNV-1a hash of the key bytes.
+	 */
+	struct Hash {
+		size_t operator()(const StringData& s) const {
+			size_t h = 14695981039346656037ULL;
+			for (size_t i = 0; i < s.size(); i++) {
+				h = (h ^ (unsigned char)s.rawData()[i]) * 1099511628211ULL;
+			}
+			return h;
+		}
+	};
+
+	typedef unordered_map<StringData, int, Hash> KeyMap;
+
+	/*!
+	 * Owned copies of the interned keys indexed by id. The std::deque keeps each string at a fixed address so the StringData map keys stay valid.
+	 */
+	deque<string> keys;
+	KeyMap ids;
+
+public:
+	BSONKeyInternTable() {}
+	virtual ~BSONKeyInternTable() {}
+
+	/*!
+	 * \brief Look up the id of a key, assigning the next id if the key is new.
+	 * \param[in] key The key name. The key bytes need not outlive the call.
+	 * \return The key id, 0 for the first key interned, 1 for the second, etc.
+	 */
+	int intern(const StringData& key) {
+		KeyMap::const_iterator i = ids.find(key);
+		if (i != ids.end()) {
+			return i->second;
+		}
+		int id = keys.size();
+		keys.push_back(key.toString());
+		ids.insert(KeyMap::value_type(StringData(keys.back()), id));
+		return id;
+	}
+
+	/*!
+	 * \param[in] id A key id returned by intern().
+	 * \return The key name.
+	 * \throws std::out_of_range If the id was not assigned by this table.
+	 */
+	const string& key(int id) const {
+		return keys.at(id);
+	}
+
+	/*!
+	 * \return The count of distinct keys interned.
+	 */
+	int size() const {
+		return keys.size();
+	}
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+#endif /* BSONKEYINTERNTABLE_HPP_ */
@@ -33,7 +33,14 @@
 
 //----------------------------------------------------------------------------
 
+#include <bitset>
+
 #include <mongotype.hpp>
+#include <Parameters.hpp>
+#include <OutputSink.hpp>
+#include <BSONPathFilter.hpp>
+#include <BSONKeyInternTable.hpp>
+#include <WorkerPool.hpp>
 
 //----------------------------------------------------------------------------
 
@@ -93,8 +100,14 @@ private:
 
 	/**
 	 * Key name of the BSON object/array/element, or the empty string if this is the root object.
+	 * A non-owning view of the key bytes within the parsed BSON object.
+	 */
+	StringData key;
+
+	/**
+	 * The id of \ref key in the parser's BSONKeyInternTable, or BSONKeyInternTable::NO_ID if keys are not being interned.
 	 */
-	const string& key;
+	int keyId;
 
 	/**
 	 * The zero based index of the BSON object/array/element within the parent object.
@@ -116,10 +129,17 @@ private:
 	/**
 	 * The count of all BSON element(s) within the containing BSON array, or 0 if the BSON element is not contained within a BSON array.
 	 * - arrayCount == 0 if object is not contained in an array, or ...
-	 * - arrayCount > 0 if object is contained within an array.
+	 * - arrayCount > 0 if object is contained within an array, or ...
+	 * - arrayCount == \ref ARRAY_COUNT_UNKNOWN if the visitor declined array counting. See IBSONObjectVisitor::isArrayCountRequired().
 	 */
 	int arrayCount;
 
+public:
+	/**
+	 * The \ref arrayCount value used when the array elements were not counted.
+	 */
+	static const int ARRAY_COUNT_UNKNOWN = -1;
+
 private:
 	/**
 	 * Throw an error if the wrong type of fetch from the union occurs.
@@ -137,13 +157,14 @@ public:
 	 * Construct a BSONParserStackItem containing a pointer to a mongo::BSONObj. The \ref ItemType is implicitly set to \ref OBJECT.
 	 * \param[in] object The pointer to the mongo::BSONObj.
 	 * \param[in] pkey The BSON key string of the contained mongo::BSONObj.
+	 * \param[in] pkeyId The interned id of the key. See \ref keyId.
 	 * \param[in] pelementIndex The element index of the contained mongo::BSONObj See \ref elementIndex.
 	 * \param[in] pelementCount The element count. See \ref elementCount.
 	 * \param[in] parrayIndex The array index of the contained mongo::BSONObj See \ref arrayIndex.
 	 * \param[in] parrayCount The array count. See \ref arrayCount.
 	 */
-	BSONParserStackItem(const BSONObj* object, const string& pkey, int pelementIndex, int pelementCount, int parrayIndex, int parrayCount)
-		: type(OBJECT), item(object), key(pkey), elementIndex(pelementIndex), elementCount(pelementCount), arrayIndex(parrayIndex), arrayCount(parrayCount) {}
+	BSONParserStackItem(const BSONObj* object, StringData pkey, int pkeyId, int pelementIndex, int pelementCount, int parrayIndex, int parrayCount)
+		: type(OBJECT), item(object), key(pkey), keyId(pkeyId), elementIndex(pelementIndex), elementCount(pelementCount), arrayIndex(parrayIndex), arrayCount(parrayCount) {}
 	/**
 	 * Construct a BSONParserStackItem containing a pointer to a mongo::BSONElement.
 	 * \param[in] ptype The \ref ItemType of this element. The valid types are:
@@ -151,13 +172,14 @@ public:
 	 * - \ref ELEMENT
 	 * \param[in] element The pointer to the mongo::BSONElement.
 	 * \param[in] pkey The BSON key string of the contained mongo::BSONObj.
+	 * \param[in] pkeyId The interned id of the key. See \ref keyId.
 	 * \param[in] pelementIndex The element index of the contained mongo::BSONObj See \ref elementIndex.
 	 * \param[in] pelementCount The element count. See \ref elementCount.
 	 * \param[in] parrayIndex The array index of the contained mongo::BSONObj See \ref arrayIndex.
 	 * \param[in] parrayCount The array count. See \ref arrayCount.
 	 */
-	BSONParserStackItem(ItemType ptype, const BSONElement* element, const string& pkey, int pelementIndex, int pelementCount, int parrayIndex, int parrayCount)
-		: type(ptype), item(element), key(pkey), elementIndex(pelementIndex), elementCount(pelementCount), arrayIndex(parrayIndex), arrayCount(parrayCount) {}
+	BSONParserStackItem(ItemType ptype, const BSONElement* element, StringData pkey, int pkeyId, int pelementIndex, int pelementCount, int parrayIndex, int parrayCount)
+		: type(ptype), item(element), key(pkey), keyId(pkeyId), elementIndex(pelementIndex), elementCount(pelementCount), arrayIndex(parrayIndex), arrayCount(parrayCount) {}
 
 	ItemType getType() const {
 		return type;
@@ -178,10 +200,14 @@ public:
 		return *item.element;
 	}
 
-	const string& getKey() const {
+	StringData getKey() const {
 		return key;
 	}
 
+	int getKeyId() const {
+		return keyId;
+	}
+
 	int getElementIndex() const {
 		return elementIndex;
 	}
@@ -213,7 +239,9 @@ public:
 		default:
 			throw std::logic_error(string("toString Undefined ItemType!"));
 		}
-		s += ",\"" + key + "\"",
+		s += ",\"";
+		s.append(key.rawData(), key.size());
+		s += "\"";
 		s += "," + to_string(elementIndex);
 		s += "," + to_string(elementCount);
 		s += "," + to_string(arrayIndex);
@@ -235,12 +263,19 @@ public:
  */
 
 class BSONParserStack {
-	typedef std::deque<std::unique_ptr<const BSONParserStackItem>> Stack;
+	typedef std::deque<BSONParserStackItem> Stack;
 
+	/**
+	 * Item storage, grown to the deepest nesting parsed and reused thereafter, only the first \ref count items are on the stack.
+	 * A std::deque keeps the items at a fixed address as it grows.
+	 */
 	Stack stack;
+	int count;
 
 public:
-	int depth() const { return stack.size(); }
+	BSONParserStack() : count(0) {}
+
+	int depth() const { return count; }
 
 private:
 	void throwCount(int count) const {
@@ -251,26 +286,17 @@ private:
 
 protected:
 
-	/**
-	 * \brief Pop the TOS item.
-	 * \return The pointer to the read-only stack item.
-	 * \throws std::logic_error On stack underflow.
-	 * \note Releases item ownership to caller, i.e., the called is now responsible for freeing the returned item.
-	 */
-	const BSONParserStackItem* pop() {
-		throwCount(1);
-		const BSONParserStackItem* rv = stack.back().release();
-		stack.pop_back();
-		return rv;
-	}
-
 	/**
 	 * \brief Push the item.
-	 * \param[in] item The reference to the item to be stored on the stack.
-	 * \note Takes item ownership from caller, i.e., if not first popped the contained item(s) will be destroyed and freed when the BSONParserStack instance is destroyed .
+	 * \param[in] item The item to be copied onto the stack, into the storage of a previously dropped item if there is one.
 	 */
-	void push(const BSONParserStackItem* item) {
-		stack.push_back(unique_ptr<const BSONParserStackItem>(item));
+	void push(const BSONParserStackItem& item) {
+		if (count < (int)stack.size()) {
+			stack[count] = item;
+		} else {
+			stack.push_back(item);
+		}
+		count++;
 	}
 
 public:
@@ -287,7 +313,7 @@ public:
 	const BSONParserStackItem& item(int index) const {
 		if (index >= 0) {
 			throwCount(index+1);
-			return *(stack[index].get());
+			return stack[index];
 		} else {
 			int i = depth() + index;
 			return item(i);
@@ -305,40 +331,51 @@ public:
 	}
 
 	/**
-	 * \brief Wrap the mongo::BSONObj object in a dynamically allocated \ref BSONParserStackItem and push the resultant BSONParserStackItem to the stack.
-	 * \param[in] object The reference to the BSON object to be encapsulated in a BSONParserStackItem object and pushed on the stack.
+	 * \brief Push a \ref BSONParserStackItem referencing the mongo::BSONObj object, stored in the reused deque slot of a previously dropped item if there is one.
+	 * \param[in] object The reference to the BSON object referenced by the pushed BSONParserStackItem.
 	 * \param[in] key The BSON key string of the contained mongo::BSONObj.
 	 * \param[in] elementIndex The element index of the contained mongo::BSONObj See \ref BSONParserStackItem::elementIndex.
 	 * \param[in] elementCount The element count. See \ref BSONParserStackItem::elementCount.
 	 * \param[in] arrayIndex The array index of the contained mongo::BSONObj See \ref BSONParserStackItem::arrayIndex.
 	 * \param[in] arrayCount The array count. See \ref BSONParserStackItem::arrayCount.
-	 * \see void BSONParserStack::push(const BSONParserStackItem* item)
+	 * \param[in] keyId The interned id of the key. See \ref BSONParserStackItem::keyId.
+	 * \see void BSONParserStack::push(const BSONParserStackItem& item)
 	 */
-	void push(const BSONObj& object, const string& key = string(), int elementIndex=0, int elementCount=1, int arrayIndex=-1, int arrayCount=0) {
-		push(new BSONParserStackItem(&object, key, elementIndex, elementCount, arrayIndex, arrayCount));
+	void push(const BSONObj& object, StringData key = StringData(), int elementIndex=0, int elementCount=1, int arrayIndex=-1, int arrayCount=0, int keyId=BSONKeyInternTable::NO_ID) {
+		push(BSONParserStackItem(&object, key, keyId, elementIndex, elementCount, arrayIndex, arrayCount));
 	}
 
 	/**
-	 * \brief Wrap the mongo::BSONElement element/array in a dynamically allocated \ref BSONParserStackItem and push the resultant BSONParserStackItem to the stack.
-	 * \param[in] type The ItemType of this element. For valid values see \ref BSONParserStackItem::BSONParserStackItem(ItemType ptype, const BSONElement* element, const string& pkey, int pelementIndex, int pelementCount, int parrayIndex, int parrayCount).
-	 * \param[in] element The reference to the BSON element to be encapsulated in a BSONParserStackItem object and pushed on the stack.
+	 * \brief Push a \ref BSONParserStackItem referencing the mongo::BSONElement element/array, stored in the reused deque slot of a previously dropped item if there is one.
+	 * \param[in] type The ItemType of this element. For valid values see \ref BSONParserStackItem::BSONParserStackItem(ItemType ptype, const BSONElement* element, StringData pkey, int pkeyId, int pelementIndex, int pelementCount, int parrayIndex, int parrayCount).
+	 * \param[in] element The reference to the BSON element referenced by the pushed BSONParserStackItem.
 	 * \param[in] key The BSON key string of the contained mongo::BSONObj.
 	 * \param[in] elementIndex The element index of the contained mongo::BSONObj See \ref BSONParserStackItem::elementIndex.
 	 * \param[in] elementCount The element count. See \ref BSONParserStackItem::elementCount.
 	 * \param[in] arrayIndex The array index of the contained mongo::BSONObj See \ref BSONParserStackItem::arrayIndex.
 	 * \param[in] arrayCount The array count. See \ref BSONParserStackItem::arrayCount.
-	 * \see void BSONParserStack::push(const BSONParserStackItem* item)
+	 * \param[in] keyId The interned id of the key. See \ref BSONParserStackItem::keyId.
+	 * \see void BSONParserStack::push(const BSONParserStackItem& item)
 	 */
-	void push(BSONParserStackItem::ItemType type, const BSONElement& element, const string& key = string(), int elementIndex=0, int elementCount=1, int arrayIndex=-1, int arrayCount=0) {
-		push(new BSONParserStackItem(type, &element, key, elementIndex, elementCount, arrayIndex, arrayCount));
+	void push(BSONParserStackItem::ItemType type, const BSONElement& element, StringData key = StringData(), int elementIndex=0, int elementCount=1, int arrayIndex=-1, int arrayCount=0, int keyId=BSONKeyInternTable::NO_ID) {
+		push(BSONParserStackItem(type, &element, key, keyId, elementIndex, elementCount, arrayIndex, arrayCount));
 	}
 
 	/**
 	 * \brief Drop the TOS.
-	 * \note TOS item is destroyed.
+	 * \throws std::logic_error On stack underflow.
+	 * \note The TOS item's storage is kept for reuse by the next push.
 	 */
 	void drop() {
-		delete pop();
+		throwCount(1);
+		count--;
+	}
+
+	/**
+	 * \brief Drop all the items, e.g., after a parse abandoned by an exception.
+	 */
+	void clear() {
+		count = 0;
 	}
 
 	string toString() const {
@@ -354,6 +391,48 @@ public:
 
 //----------------------------------------------------------------------------
 
+/*!
+ * \class BSONElision
+ * \brief Summary of the elements of a BSON region omitted from a parse per --max-depth or --max-array-elems.
+ *
+ * The summary is computed from the element type bytes alone, none of the omitted elements are parsed or rendered.
+ */
+
+class BSONElision {
+public:
+	/*!
+	 * \enum Kind The reason for the omission.
+	 */
+	enum Kind {
+		DEPTH,		/*!< An object or array nested deeper than --max-depth. Its elements are summarized. */
+		ARRAY_TAIL	/*!< The elements of an array beyond --max-array-elems. */
+	};
+
+	Kind kind;					/*!< The reason for the omission. */
+	BSONType type;				/*!< The BSONType of the omitted object or array, Array for an ARRAY_TAIL. */
+	int index;					/*!< The array index of the first omitted element of an ARRAY_TAIL, 0 for DEPTH. */
+	int count;					/*!< The count of omitted elements. */
+	std::bitset<256> types;		/*!< The union of the omitted elements' BSONType values, indexed by the type byte. */
+
+	BSONElision(Kind pkind, BSONType ptype, int pindex = 0) : kind(pkind), type(ptype), index(pindex), count(0) {}
+
+	/*!
+	 * \brief Count an omitted element.
+	 * \param[in] e The element.
+	 */
+	void add(const BSONElement& e) {
+		count++;
+		types.set((unsigned char)e.type());
+	}
+
+	/*!
+	 * \return The human readable summary, i.e., "[... 3 elements: NumberInt|String]" or "... 99990 more elements: NumberInt".
+	 */
+	string summary() const;
+};
+
+//----------------------------------------------------------------------------
+
 /*!
  * \interface IBSONObjectVisitor
  * \brief Visitor interface for parsing nested BSON data objects.
@@ -428,6 +507,49 @@ public:
 	 * Invoked once per each terminal BSON element that is not a BSON object or a BSON array.
 	 */
 	virtual void onElement(const BSONParserStack& stack) = 0;
+
+	/*!
+	 * \fn void onElided(const BSONParserStack& stack, const BSONElision& elision)
+	 * \brief BSON Elision Event
+	 * \param[in] stack The \ref BSONParserStack object containing the current parse context.
+	 * \param[in] elision The summary of the omitted elements.
+	 *
+	 * Invoked in place of the events of an omitted region:
+	 * - BSONElision::DEPTH: In place of the object or array events, with the object or array pushed as an ELEMENT item.
+	 * - BSONElision::ARRAY_TAIL: After the last parsed element of the array, with the array at the top of the stack.
+	 */
+	virtual void onElided(const BSONParserStack& stack, const BSONElision& elision) = 0;
+
+	/*!
+	 * \fn bool isArrayCountRequired() const
+	 * \brief BSON Array Count Query
+	 * \return True if the visitor reads BSONParserStackItem::getArrayCount(), false otherwise.
+	 *
+	 * Counting the elements of a BSON array requires an extra pass over the array. Visitors that never
+	 * read the array count may return false to skip that pass, in which case the array count is reported
+	 * as BSONParserStackItem::ARRAY_COUNT_UNKNOWN.
+	 */
+	virtual bool isArrayCountRequired() const { return true; }
+
+	/*!
+	 * \fn IBSONObjectVisitor* fork(OutputSink& fragment)
+	 * \brief BSON Array Split Query
+	 * \param[in] fragment The memory sink receiving the forked visitor's output.
+	 * \return A new visitor, owned by the caller, continuing this visitor's state at the current ARRAY_START but writing to fragment,
+	 * or NULL if the visitor cannot be forked.
+	 *
+	 * BSONObjectParser may split the elements of a large array into ranges parsed concurrently, each by a forked visitor, when
+	 * --threads is greater than 1. The forked visitors only receive the events of their range, and their fragments are passed
+	 * to join() in array order before this visitor receives the array's remaining events.
+	 */
+	virtual IBSONObjectVisitor* fork(OutputSink& fragment) { return NULL; }
+
+	/*!
+	 * \fn void join(const OutputSink& fragment)
+	 * \brief BSON Array Split Output Event
+	 * \param[in] fragment The output of a visitor returned by fork().
+	 */
+	virtual void join(const OutputSink& fragment) {}
 };
 
 //----------------------------------------------------------------------------
@@ -453,6 +575,106 @@ protected:
 	IBSONObjectVisitor& visitor;
 	BSONParserStack stack;
 
+	/*!
+	 * The path filter consulted before descending into an element, or NULL to parse every element.
+	 */
+	const BSONPathFilter* pathFilter;
+
+	/*!
+	 * The keys of the object path being parsed, excluding array element indexes. Only maintained when \ref pathFilter is set.
+	 */
+	vector<StringData> path;
+
+	/*!
+	 * The BSONPathFilter::Match result of \ref path.
+	 */
+	BSONPathFilter::Match pathMatch;
+
+	/*!
+	 * The table used to assign BSONParserStackItem::getKeyId() ids, or NULL if keys are not interned.
+	 */
+	BSONKeyInternTable* keyTable;
+
+	/*!
+	 * True to parse an object's scalar elements before its embedded objects and arrays, per --scalarfirst.
+	 */
+	bool scalarFirst;
+
+	/*!
+	 * The deepest stack depth at which objects and arrays are parsed, deeper ones are summarized per --max-depth. Zero for no limit.
+	 */
+	int maxDepth;
+
+	/*!
+	 * The count of elements parsed per array, further elements are summarized per --max-array-elems. Zero for no limit.
+	 */
+	int maxArrayElems;
+
+	/*!
+	 * The count of threads parsing the elements of a large array per --threads, 1 to never split arrays.
+	 */
+	int threads;
+
+	/*!
+	 * The count of elements from which an array is split between \ref threads per --split-elems.
+	 */
+	int splitElems;
+
+	/*!
+	 * \brief Per object nesting level element buffers.
+	 *
+	 * Indexed by stack depth and reused by every object parsed at that depth, so that ordering the elements of an object does not allocate once the buffers have grown.
+	 */
+	struct Level {
+		vector<BSONElement> elements;			/*!< The object's selected elements in key order. */
+		vector<BSONPathFilter::Match> matches;	/*!< The BSONPathFilter::Match of each element, only when \ref pathFilter is set. */
+		vector<int> order;						/*!< The indexes of \ref elements with the scalars first, only when \ref scalarFirst is set. */
+	};
+	deque<Level> levels;
+
+	//----------------------------------------------------------------------------
+
+	/*!
+	 * \brief Test whether an element within the current \ref path is selected by the path filter.
+	 * \param[in] element The object element or array element.
+	 * \param[in] match The BSONPathFilter::Match of the element's path.
+	 * \return True if the element is to be parsed, false if it is to be skipped.
+	 *
+	 * Objects and arrays on a PARTIAL path are descended into as they may contain an included path, scalars are skipped.
+	 */
+
+	static bool isSelected(const BSONElement& element, BSONPathFilter::Match match) {
+		switch (match) {
+		case BSONPathFilter::INCLUDED:
+			return true;
+		case BSONPathFilter::PARTIAL:
+			return element.type() == BSONType::Object || element.type() == BSONType::Array;
+		default:
+			return false;
+		}
+	}
+
+	/*!
+	 * \param[in] key The key to intern.
+	 * \return The key's id in \ref keyTable, or BSONKeyInternTable::NO_ID if keys are not interned.
+	 */
+
+	int internKey(StringData key) {
+		return keyTable == NULL ? BSONKeyInternTable::NO_ID : keyTable->intern(key);
+	}
+
+	/*!
+	 * \param[in] depth The stack depth of the object.
+	 * \return The reusable element buffers for objects at the given depth.
+	 */
+
+	Level& level(int depth) {
+		while ((int)levels.size() <= depth) {
+			levels.push_back(Level());
+		}
+		return levels[depth];
+	}
+
 	//----------------------------------------------------------------------------
 
 	/*!
@@ -465,30 +687,64 @@ protected:
 	 * \param[in] arrayCount The array count. See \ref BSONParserStackItem::arrayCount.
 	 *
 	 * - If it is a BSON object (BSONObj) parse it via indirect recursion by calling parseObjectRecursive().
-	 * - If it is a BSON array iterate through the contained BSONElement(s) and process via direct recursion by calling parseElementRecursive().
+	 * - If it is a BSON array iterate in place through the contained BSONElement(s) and process via direct recursion by calling parseElementRecursive().
 	 * - If it is neither an object nor an array simply invoke the visitors onElement virtual method to process the BSONElement.
 	 */
 
-	virtual void parseElementRecursive(const BSONElement& element, string& key, int elementIndex=0, int elementCount=1, int arrayIndex = -1, int arrayCount = 0) {
+	virtual void parseElementRecursive(const BSONElement& element, StringData key, int elementIndex=0, int elementCount=1, int arrayIndex = -1, int arrayCount = 0) {
 		BSONType btype = element.type();
+		if ((btype == BSONType::Object || btype == BSONType::Array) && maxDepth > 0 && stack.depth() >= maxDepth) {
+			BSONElision elision(BSONElision::DEPTH, btype);
+			BSONObjIterator i(element.embeddedObject());
+			while (i.more()) {
+				elision.add(i.next());
+			}
+			stack.push(BSONParserStackItem::ItemType::ELEMENT, element, key, elementIndex, elementCount, arrayIndex, arrayCount, internKey(key));
+			visitor.onElided(stack, elision);
+			stack.drop();
+			return;
+		}
 		switch (btype) {
 		case BSONType::Object:
 			{
-				const BSONObj& bobj = element.Obj();
-				string k(element.fieldName());
-				parseObjectRecursive(bobj, k, elementIndex, elementCount, arrayIndex, arrayCount);
+				const BSONObj bobj(element.embeddedObject());
+				parseObjectRecursive(bobj, key, elementIndex, elementCount, arrayIndex, arrayCount);
 			}
 			break;
 		case BSONType::Array:
 			{
-				stack.push(BSONParserStackItem::ItemType::ARRAY, element, key, elementIndex, elementCount, arrayIndex, arrayCount);
-				std::vector<BSONElement> elementArray = element.Array();
-				int elementArrayCount = elementArray.size();
+				stack.push(BSONParserStackItem::ItemType::ARRAY, element, key, elementIndex, elementCount, arrayIndex, arrayCount, internKey(key));
+				const BSONObj elementArray(element.embeddedObject()); // Non-owning view of the array's BSON bytes.
+				int elementArrayCount = BSONParserStackItem::ARRAY_COUNT_UNKNOWN;
+				if (visitor.isArrayCountRequired()) {
+					if (pathMatch == BSONPathFilter::PARTIAL) {
+						elementArrayCount = 0;
+						BSONObjIterator i(elementArray);
+						while (i.more()) {
+							elementArrayCount += isSelected(i.next(), pathMatch);
+						}
+					} else {
+						elementArrayCount = elementArray.nFields();
+					}
+				}
 				visitor.onArrayStart(stack);
 				int elementArrayIndex = 0;
-				for (BSONElement e : elementArray) {
-					string k(e.fieldName());
-					parseElementRecursive(e, k, elementIndex, elementCount, elementArrayIndex++, elementArrayCount);
+				BSONElision tail(BSONElision::ARRAY_TAIL, BSONType::Array, maxArrayElems);
+				if (threads < 2 || !parseArraySplit(elementArray, elementIndex, elementCount, elementArrayCount, tail)) {
+					BSONObjIterator i(elementArray);
+					while (i.more()) {
+						BSONElement e = i.next();
+						if (isSelected(e, pathMatch)) { // Array elements share the array's path.
+							if (maxArrayElems > 0 && elementArrayIndex >= maxArrayElems) {
+								tail.add(e);
+							} else {
+								parseElementRecursive(e, e.fieldNameStringData(), elementIndex, elementCount, elementArrayIndex++, elementArrayCount);
+							}
+						}
+					}
+				}
+				if (tail.count > 0) {
+					visitor.onElided(stack, tail);
 				}
 				visitor.onArrayEnd(stack);
 				stack.drop();
@@ -496,7 +752,7 @@ protected:
 			break;
 		default:
 			{
-				stack.push(BSONParserStackItem::ItemType::ELEMENT, element, key, elementIndex, elementCount, arrayIndex, arrayCount);
+				stack.push(BSONParserStackItem::ItemType::ELEMENT, element, key, elementIndex, elementCount, arrayIndex, arrayCount, internKey(key));
 				visitor.onElement(stack);
 				stack.drop();
 			}
@@ -506,6 +762,25 @@ protected:
 
 	//----------------------------------------------------------------------------
 
+	/*!
+	 * \brief Parse the elements of a large array concurrently.
+	 * \param[in] array The array at the top of the stack, after its ARRAY_START event.
+	 * \param[in] elementIndex The element index of the array. See \ref BSONParserStackItem::elementIndex.
+	 * \param[in] elementCount The element count. See \ref BSONParserStackItem::elementCount.
+	 * \param[in] arrayCount The array count reported to the array's elements. See \ref BSONParserStackItem::arrayCount.
+	 * \param[in,out] tail The elision accumulating the elements beyond \ref maxArrayElems.
+	 * \return True if the array's elements were parsed, false if the array is too small or the visitor cannot fork and the caller must parse it.
+	 *
+	 * The selected elements are split into ranges, more ranges than \ref threads to even out the work. Each range is parsed by
+	 * a parser holding a copy of the stack and a visitor fork()ed into its own fragment. The calling thread and the idle
+	 * threads of the WorkerPool::shared() pool take the next unparsed range as they finish one, and the fragments are
+	 * join()ed in array order once all are parsed. Every parser splits through the one pool of \ref threads - 1 threads,
+	 * so the parsers of concurrent renderers, e.g., of the BSONParallelRenderer workers, add no more threads than that.
+	 */
+	bool parseArraySplit(const BSONObj& array, int elementIndex, int elementCount, int arrayCount, BSONElision& tail);
+
+	//----------------------------------------------------------------------------
+
 	/*!
 	 * \brief Recursively parse a BSON Object.
 	 * \param[in] object The BSON object to process.
@@ -517,20 +792,59 @@ protected:
 	 * - arrayIndex == -1 if the element is not contained in an array.
 	 * - arrayIndex >= 0 if the element is contained within an array.
 	 *
-	 * Iterate through all the BSONElement(s) contained in the BSONObj and process them via indirect recursion by calling parseElementRecursive().
+	 * Iterate through all the BSONElement(s) contained in the BSONObj in key order and process them via indirect recursion by calling parseElementRecursive().
+	 * If a path filter is set, elements that are not selected are skipped without being parsed.
 	 */
 
-	virtual void parseObjectRecursive(const BSONObj& object, string& key, int elementIndex=0, int elementCount=1, int arrayIndex = -1, int arrayCount = 0) {
-		stack.push(object, key, elementIndex, elementCount, arrayIndex, arrayCount);
+	virtual void parseObjectRecursive(const BSONObj& object, StringData key, int elementIndex=0, int elementCount=1, int arrayIndex = -1, int arrayCount = 0) {
+		stack.push(object, key, elementIndex, elementCount, arrayIndex, arrayCount, internKey(key));
 		visitor.onObjectStart(stack);
-		set<string> keys;
-		object.getFieldNames(keys); // Get the key names of the BSON object.
-		int ei = 0;
-		int ec = keys.size();
-		for (string key : keys) {
-			BSONElement e = object.getField(key);
-			parseElementRecursive(e, key, ei++, ec, arrayIndex);
+		Level& l = level(stack.depth());
+		sortElements(object, l.elements);
+		if (pathFilter != NULL) {
+			l.matches.resize(l.elements.size());
+			size_t n = 0;
+			for (size_t i = 0; i < l.elements.size(); i++) {
+				path.push_back(l.elements[i].fieldNameStringData());
+				BSONPathFilter::Match m = pathFilter->match(path);
+				path.pop_back();
+				if (isSelected(l.elements[i], m)) {
+					l.elements[n] = l.elements[i];
+					l.matches[n++] = m;
+				}
+			}
+			l.elements.resize(n);
+		}
+		const BSONPathFilter::Match objectMatch = pathMatch;
+		int ec = l.elements.size();
+		if (scalarFirst) {
+			// Scalars fill the order from the front and containers from the back, the containers are then put back in key order.
+			l.order.resize(ec);
+			int front = 0, back = ec;
+			for (int i = 0; i < ec; i++) {
+				BSONType t = l.elements[i].type();
+				if (t == BSONType::Object || t == BSONType::Array) {
+					l.order[--back] = i;
+				} else {
+					l.order[front++] = i;
+				}
+			}
+			std::reverse(l.order.begin() + back, l.order.end());
 		}
+		for (int ei = 0; ei < ec; ei++) {
+			const int i = scalarFirst ? l.order[ei] : ei;
+			const BSONElement& e = l.elements[i];
+			StringData k(e.fieldNameStringData());
+			if (pathFilter != NULL) {
+				path.push_back(k);
+				pathMatch = l.matches[i];
+			}
+			parseElementRecursive(e, k, ei, ec, arrayIndex);
+			if (pathFilter != NULL) {
+				path.pop_back();
+			}
+		}
+		pathMatch = objectMatch;
 		visitor.onObjectEnd(stack);
 		stack.drop();
 	}
@@ -545,22 +859,88 @@ public:
 	 * Construct a parser and register the parsing event handler/visitor.
 	 */
 
-	BSONObjectParser(IBSONObjectVisitor& pvisitor) : visitor(pvisitor) {}
+	BSONObjectParser(IBSONObjectVisitor& pvisitor) : visitor(pvisitor), pathFilter(NULL), pathMatch(BSONPathFilter::INCLUDED), keyTable(NULL), scalarFirst(false), maxDepth(0), maxArrayElems(0), threads(1), splitElems(0) {}
+
+	/*!
+	 * \brief Construct a BSON Object parser configured by the command line parameters.
+	 * \param[in] pvisitor The instance of the IBSONObjectVisitor visitor subclass that will receive the parse events.
+	 * \param[in] params The command line parameters supplying the parse options, i.e., the --include and --exclude path filter, --scalarfirst,
+	 * --max-depth, --max-array-elems, --threads and --split-elems.
+	 */
+
+	BSONObjectParser(IBSONObjectVisitor& pvisitor, const Parameters& params) : visitor(pvisitor), pathFilter(NULL), pathMatch(BSONPathFilter::INCLUDED), keyTable(NULL),
+			scalarFirst(params.isScalarFirst()), maxDepth(params.getMaxDepth()), maxArrayElems(params.getMaxArrayElems()),
+			threads(params.getThreads()), splitElems(params.getSplitElems()) {
+		if (params.getPathFilter().isActive()) {
+			pathFilter = &params.getPathFilter();
+		}
+	}
+
+protected:
+	/*!
+	 * \brief Construct a parser for a range of array elements split off by parseArraySplit().
+	 * \param[in] parent The parser splitting the array, whose options, path and stack are copied.
+	 * \param[in] pvisitor The visitor fork()ed for the range.
+	 */
+
+	BSONObjectParser(const BSONObjectParser& parent, IBSONObjectVisitor& pvisitor) : visitor(pvisitor), stack(parent.stack), pathFilter(parent.pathFilter),
+			path(parent.path), pathMatch(parent.pathMatch), keyTable(NULL), scalarFirst(parent.scalarFirst), maxDepth(parent.maxDepth),
+			maxArrayElems(parent.maxArrayElems), threads(1), splitElems(0) {}
+
+public:
 	virtual ~BSONObjectParser() {}
 
 	//----------------------------------------------------------------------------
 
+	/*!
+	 * \brief Intern the keys of the parsed elements.
+	 * \param[in] table The table assigning the ids reported by BSONParserStackItem::getKeyId(), or NULL to stop interning.
+	 * The table must outlive the parses that use it, and is normally shared by all the documents of a run.
+	 */
+
+	void setKeyInternTable(BSONKeyInternTable* table) {
+		keyTable = table;
+	}
+
+	//----------------------------------------------------------------------------
+
+	/*!
+	 * \brief Collect the elements of a BSON object in key name order.
+	 * \param[in] object The BSON object.
+	 * \param[out] elements The elements in ascending key name order. Only the first of any duplicate keys is kept.
+	 */
+
+	static void sortElements(const BSONObj& object, vector<BSONElement>& elements) {
+		elements.clear();
+		BSONObjIterator i(object);
+		while (i.more()) {
+			elements.push_back(i.next());
+		}
+		std::sort(elements.begin(), elements.end(), [] (const BSONElement& a, const BSONElement& b) -> bool {
+			int c = strcmp(a.fieldName(), b.fieldName());
+			return c < 0 || (c == 0 && a.rawdata() < b.rawdata()); // Duplicates in document order.
+		});
+		elements.erase(std::unique(elements.begin(), elements.end(), [] (const BSONElement& a, const BSONElement& b) -> bool {
+			return strcmp(a.fieldName(), b.fieldName()) == 0;
+		}), elements.end());
+	}
+
+	//----------------------------------------------------------------------------
+
 	/*!
 	 * \brief Parse a BSON Object (BSONObj)
 	 * \param[in] object The BSON object to parse.
 	 *
 	 * Parse the given BSON object and invoke the event handlers of the IBSONObjectVisitor visitor _subclass_ registered by constructor BSONObjectParser::BSONObjectParser(IBSONObjectVisitor& pvisitor).
+	 * A parser may parse any number of objects in turn, reusing its stack and element buffers.
 	 */
 
 	virtual void parse(const BSONObj& object) {
+		stack.clear();
 		visitor.onParseStart();
-		string emptyString("");
-		parseObjectRecursive(object, emptyString);
+		path.clear();
+		pathMatch = pathFilter == NULL ? BSONPathFilter::INCLUDED : pathFilter->match(path);
+		parseObjectRecursive(object, StringData());
 		visitor.onParseEnd();
 	}
 
@@ -569,6 +949,40 @@ public:
 
 //----------------------------------------------------------------------------
 
+/*!
+ * \class BSONLazyObjectParser
+ * \brief A renderer's own BSONObjectParser, constructed by the first parse.
+ *
+ * A renderer driven through IBSONRenderer::getVisitor() by an external parser, e.g., one of the renderers of a
+ * BSONCompositeRenderer, never parses a document itself and so never constructs the parser's stack and element buffers.
+ */
+
+class BSONLazyObjectParser {
+	IBSONObjectVisitor& visitor;
+	const Parameters& params;
+	unique_ptr<BSONObjectParser> parser;
+
+public:
+	/*!
+	 * \param[in] pvisitor The visitor receiving the parse events.
+	 * \param[in] pparams The command line parameters supplying the parse options. See BSONObjectParser::BSONObjectParser(IBSONObjectVisitor&, const Parameters&).
+	 */
+	BSONLazyObjectParser(IBSONObjectVisitor& pvisitor, const Parameters& pparams) : visitor(pvisitor), params(pparams) {}
+
+	/*!
+	 * \brief Parse a BSON Object, constructing the parser on first use. See BSONObjectParser::parse().
+	 * \param[in] object The BSON object to parse.
+	 */
+	void parse(const BSONObj& object) {
+		if (!parser) {
+			parser.reset(new BSONObjectParser(visitor, params));
+		}
+		parser->parse(object);
+	}
+};
+
+//----------------------------------------------------------------------------
+
 } /* namespace mongotype */
 
 //----------------------------------------------------------------------------
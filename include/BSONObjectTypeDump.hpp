@@ -35,13 +35,15 @@
 #include <IBSONRenderer.hpp>
 #include <BSONTypeFormatter.hpp>
 #include <BSONObjectParser.hpp>
+#include <BSONValueWriter.hpp>
+#include <IndentTable.hpp>
 
 namespace mongotype {
 
 /*!
  * \brief Human readable BSON Object Dump
  *
- * Provides an std::ostream comparable output operator for dumping a human readable text
+ * Provides an output operator for dumping a human readable text
  * version of the given BSON object. BSONObjectTypeDump implements interface IBSONObjectVisitor and
  * uses the BSON object parsing events to output the BSON object's text representation.
  *
@@ -50,17 +52,15 @@ namespace mongotype {
 
 class BSONObjectTypeDump : virtual public IBSONRenderer, virtual protected IBSONObjectVisitor {
 	Parameters& params;
-	string indentStr;
+	IndentTable indent;
 	string initialToken;
 	int level;
-	function<ostream&()> getOStream; // std::function required to store a closure.
+	BSONTypeFormatCache typeStrings;
+	BSONLazyObjectParser objectParser; // Parses every rendered document, reusing its buffers.
+	OutputSink* out; // The sink written to, see setOutputSink().
 
-	string istr() {
-		string s;
-		for (int i=0; i<level; i++) {
-			s += indentStr;
-		}
-		return s;
+	void newLine() {
+		indent.writeLine(*out, level); // The newline and indentation as one slice of the precomputed table.
 	}
 
 protected: // IBSONObjectVisitor overrides.
@@ -72,22 +72,23 @@ protected: // IBSONObjectVisitor overrides.
 	virtual void onParseEnd() {	}
 
 	virtual void onObjectStart(const BSONParserStack& stack) {
-		getOStream() << "\n" << istr(); // Output a newline and indent.
+		newLine(); // Output a newline and indent.
 		if (stack.top().getArrayIndex() >= 0) { // If the object is an element of an array...
-			getOStream() << "[" << stack.top().getArrayIndex() << "]: "; // Output an array index first.
+			*out << "[" << stack.top().getArrayIndex() << "]: "; // Output an array index first.
 		}
-		getOStream() << "{"; // Output the opening bracket for the object.
+		*out << "{"; // Output the opening bracket for the object.
 		level++; // Increase the indent for the object's BSON elements.
 	}
 
 	virtual void onObjectEnd(const BSONParserStack& stack) {
 		level--; // Decrease the indent level after the object's elements.
-		getOStream() << "\n" << istr() << "}"; // Output a newline, indent, and bracket closing the object.
+		newLine(); // Output a newline, indent, and bracket closing the object.
+		*out << '}';
 
 	}
 
 	virtual void onArrayStart(const BSONParserStack& stack) {
-		getOStream() << " {ARRAY[" << stack.top().getArrayCount() << "]}"; // Output the count of array elements.
+		*out << " {ARRAY[" << stack.top().getArrayCount() << "]}"; // Output the count of array elements.
 		level++; // Increase the indent for the array's BSON elements.
 	}
 
@@ -97,8 +98,30 @@ protected: // IBSONObjectVisitor overrides.
 
 	virtual void onElement(const BSONParserStack& stack) {
 		const BSONElement& element = stack.top().getElement();
-		BSONTypeFormatter type(params, element);
-		getOStream() << "\n" << istr() << element << " " << type; // Output newline, indent, element text, element type text.
+		newLine(); // Output newline, indent, element text, element type text.
+		BSONValueWriter::writeAbbreviated(*out, element, true);
+		*out << " " << typeStrings.get(element);
+	}
+
+	virtual void onElided(const BSONParserStack& stack, const BSONElision& elision) {
+		newLine();
+		if (elision.kind == BSONElision::DEPTH) { // Output the object or array's key and type like an element.
+			const BSONElement& element = stack.top().getElement();
+			*out << element.fieldName() << ": " << elision.summary() << " " << typeStrings.get(element);
+		} else {
+			*out << elision.summary();
+		}
+	}
+
+	virtual IBSONObjectVisitor* fork(OutputSink& fragment) {
+		BSONObjectTypeDump* forked = new BSONObjectTypeDump(params, initialToken, indent.getIndentStr().c_str());
+		forked->level = level;
+		forked->setOutputSink(fragment);
+		return forked;
+	}
+
+	virtual void join(const OutputSink& fragment) {
+		*out << fragment;
 	}
 
 public: // User Interface
@@ -110,15 +133,15 @@ public: // User Interface
 	 * \param[in] pindentStr The string used to indent the text output. The indent text is prepended to the output lines once for each indent level.
 	 */
 	BSONObjectTypeDump(Parameters& pparams, string& pinitialToken, const char *pindentStr = " ") :
-		params(pparams), indentStr(pindentStr), initialToken(pinitialToken), level(0) {}
+		params(pparams), indent(pindentStr), initialToken(pinitialToken), level(0), typeStrings(pparams), objectParser(*this, pparams), out(NULL) {}
 
 	virtual ~BSONObjectTypeDump() {};
 
 	/*
-	 * \param[in] os The output stream to which the object(s) are rendered.
+	 * \param[in] sink The output sink to which the object(s) are rendered.
 	 */
-	virtual void setOutputStream(std::ostream& os) {
-		getOStream = [&] () -> ostream& { return os; }; // Wrap closure around ostream.
+	virtual void setOutputSink(OutputSink& sink) {
+		out = &sink;
 	}
 
 	/*
@@ -126,7 +149,7 @@ public: // User Interface
 	 */
 	virtual void begin(const char* prefix) {
 		if (prefix != NULL) {
-			getOStream() << prefix;
+			*out << prefix;
 		}
 	}
 
@@ -135,15 +158,31 @@ public: // User Interface
 	 */
 	virtual void end(const char* suffix) {
 		if (suffix != NULL) {
-			getOStream() << suffix;
+			*out << suffix;
 		}
 	}
 
 	virtual void render(const BSONObj& object, int docIndex, int docCount) {
-		getOStream() << "\n" << initialToken << " =>";
-		BSONObjectParser objectParser(*this); // Construct a parser around this event handler.
+		beginDocument(docIndex, docCount);
 		objectParser.parse(object);     // Parse the object and write the text output the the output stream.
 	}
+
+	virtual void renderBatch(const BSONObj* objects, int count, int firstIndex, int docCount) {
+		renderEach(*this, objects, count, firstIndex, docCount);
+		flush();
+	}
+
+	virtual void flush() {
+		out->flush();
+	}
+
+	virtual void beginDocument(int docIndex, int docCount) {
+		*out << "\n" << initialToken << " =>";
+	}
+
+	virtual IBSONObjectVisitor& getVisitor() {
+		return *this;
+	}
 };
 
 } /* namespace mongotype */
@@ -0,0 +1,183 @@
+/*!
+ * \file BSONParallelRenderer.hpp
+ * \brief Ordered Parallel Document Rendering Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef BSONPARALLELRENDERER_HPP_
+#define BSONPARALLELRENDERER_HPP_
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include <mongotype.hpp>
+#include <Parameters.hpp>
+#include <IBSONRenderer.hpp>
+#include <OutputSink.hpp>
+#include <BSONEventTape.hpp>
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \brief Renders the documents of each batch concurrently, emitting their output in document order.
+ *
+ * Enabled by --threads greater than 1. Each worker thread owns a renderer of the output style, and renders the next
+ * unclaimed document of the batch into a memory OutputSink slot. The calling thread is the sequencer: it waits for
+ * the slot of the next document in order, appends it to the output sink, and releases the slot. The slots form a
+ * ring of a fixed count of documents, so a worker never runs more than the ring ahead of the sequencer whatever the
+ * batch size. A slot's sink grows to hold its document's output, and is shrunk back to --bufsize once emitted, so
+ * memory is bounded by the output of the documents in the ring plus --bufsize per slot.
+ *
+ * Every renderer writes a document's output as a function of the document and its index alone, so the output is
+ * byte-identical to rendering the documents one after another.
+ *
+ * When the renderers implement IBSONTapeRenderer, and the batch has a document for each worker, the sequencer also parses
+ * each document onto the BSONEventTape of its slot, ahead of the workers, and the workers render the documents from
+ * their tapes. Parsing then runs concurrently with rendering, and the workers only walk the tapes.
+ *
+ * Otherwise each worker parses its own documents, and its parser may split a large array of its document. The ranges
+ * are parsed by the worker itself and the threads of the one WorkerPool::shared() pool, so --threads N runs at most N
+ * workers and N - 1 split threads. A batch of fewer documents than workers is rendered so, as a tape is never split.
+ *
+ * \see IBSONRenderer, OutputSink
+ */
+
+class BSONParallelRenderer : virtual public IBSONRenderer {
+public:
+	/*!
+	 * Constructs a renderer of the output style, called once for the sequencer and once per worker thread.
+	 */
+	typedef function<IBSONRenderer*()> Factory;
+
+private:
+	/*!
+	 * \brief The output of one document, in ring position documentIndex % slots.size().
+	 */
+	struct Slot {
+		OutputSink sink;
+		BSONEventTape tape;	/*!< The document's parse events, when the batch is rendered from tapes. */
+		bool done;	/*!< True once the document is rendered into sink and until the sequencer emits it. */
+		Slot() : done(false) {}
+	};
+
+	unique_ptr<IBSONRenderer> renderer;				/*!< Renders begin() and end() to the output sink. */
+	vector<unique_ptr<IBSONRenderer>> renderers;	/*!< One per worker thread. */
+	vector<std::thread> workers;
+	vector<unique_ptr<Slot>> slots;
+	unique_ptr<BSONEventTape::Builder> builder;		/*!< Builds the tapes, or NULL if the renderers do not render tapes. */
+	OutputSink* out;
+	const size_t bufferSize;	/*!< The --bufsize retained by each slot between documents. */
+
+	// The current batch, guarded by mutex.
+	std::mutex mutex;
+	std::condition_variable workReady;	/*!< Signalled when a document may be claimed, or on stop. */
+	std::condition_variable slotDone;	/*!< Signalled when a document is rendered, or fails. */
+	const BSONObj* objects;
+	int count;
+	int firstIndex;
+	int docCount;
+	bool taped;		/*!< True if the documents of the batch are rendered from tapes. */
+	int parsed;		/*!< The count of documents of the batch parsed onto tapes. */
+	int next;		/*!< The next document of the batch to claim. */
+	int emitted;	/*!< The count of documents of the batch emitted. */
+	int active;		/*!< The count of documents being rendered. */
+	bool stopping;
+	std::exception_ptr error;
+
+	/*!
+	 * \return The count of documents of the batch that may be claimed, those parsed onto tapes or those within the ring.
+	 */
+	int claimable() const {
+		return taped ? parsed : std::min(count, emitted + (int)slots.size());
+	}
+
+	/*!
+	 * \brief The worker thread body: render claimed documents until stopped.
+	 * \param[in] worker The renderer of the worker thread.
+	 */
+	void work(IBSONRenderer& worker);
+
+	/*!
+	 * \brief Stop and join the worker threads.
+	 */
+	void stop();
+
+public:
+	/*!
+	 * \param[in] pparams The command line parameters, --threads is the count of worker threads.
+	 * \param[in] factory Constructs the renderers of the output style.
+	 */
+	BSONParallelRenderer(Parameters& pparams, Factory factory);
+
+	/*!
+	 * Stops and joins the worker threads.
+	 */
+	virtual ~BSONParallelRenderer();
+
+	virtual void setOutputSink(OutputSink& sink) {
+		out = &sink;
+		renderer->setOutputSink(sink);
+	}
+
+	virtual void begin(const char* prefix) {
+		renderer->begin(prefix);
+	}
+
+	virtual void end(const char* suffix) {
+		renderer->end(suffix);
+	}
+
+	virtual void render(const BSONObj& object, int docIndex, int docCount) {
+		renderBatch(&object, 1, docIndex, docCount);
+	}
+
+	/*
+	 * Returns once every document of the batch is emitted, as the documents may not outlive the batch.
+	 * \throws The first exception thrown by a worker's renderer, once no worker is using the batch.
+	 */
+	virtual void renderBatch(const BSONObj* objects, int count, int firstIndex, int docCount);
+
+	virtual void flush() {
+		out->flush();
+	}
+
+	virtual void beginDocument(int docIndex, int docCount) {
+		renderer->beginDocument(docIndex, docCount);
+	}
+
+	virtual IBSONObjectVisitor& getVisitor() {
+		return renderer->getVisitor();
+	}
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+#endif /* BSONPARALLELRENDERER_HPP_ */
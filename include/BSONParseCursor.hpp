@@ -0,0 +1,229 @@
+/*!
+ * \file BSONParseCursor.hpp
+ * \brief BSON Object Pull-Parser Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ * <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef BSONPARSECURSOR_HPP_
+#define BSONPARSECURSOR_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <mongotype.hpp>
+#include <BSONObjectParser.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class BSONParseCursor
+ * \brief Pull style BSON parser.
+ *
+ * Produces the same event sequence as BSONObjectParser, with the same BSONParserStack context, but one event
+ * per call to next() instead of pushing every event into an IBSONObjectVisitor. The caller decides when to
+ * advance, so several documents may be interleaved or merged, output may be paused, and parsing may be
+ * abandoned at any point simply by not calling next() again.
+ *
+ * A cursor constructed with the command line parameters applies the same --scalarfirst ordering, --include and
+ * --exclude path filter, and --max-depth and --max-array-elems elisions as BSONObjectParser. A cursor constructed
+ * without them produces every element in key order, as a BSONObjectParser constructed without them does.
+ * Keys are never interned and arrays are never split, so BSONParserStackItem::getKeyId() is always BSONKeyInternTable::NO_ID.
+ *
+ * \b Usage:
+ * \code
+ * BSONParseCursor cursor(object, params);
+ * while (cursor.next() != BSONParseCursor::DONE) {
+ *   if (cursor.event() == BSONParseCursor::ELEMENT) {
+ *     const BSONElement& e = cursor.getStack().top().getElement();
+ *     ...
+ *   }
+ * }
+ * \endcode
+ *
+ * \note The BSONParserStack returned by getStack() and the items it contains are only valid until the next call to next().
+ * \see BSONObjectParser, IBSONObjectVisitor, BSONParserStack
+ */
+
+class BSONParseCursor {
+public:
+	/*!
+	 * \enum Event The parse event produced by the last call to next(). Each value corresponds to an IBSONObjectVisitor event.
+	 */
+	enum Event {
+		INITIAL,		/*!< No event has been produced yet. */
+		PARSE_START,	/*!< See IBSONObjectVisitor::onParseStart(). */
+		OBJECT_START,	/*!< See IBSONObjectVisitor::onObjectStart(). */
+		OBJECT_END,		/*!< See IBSONObjectVisitor::onObjectEnd(). */
+		ARRAY_START,	/*!< See IBSONObjectVisitor::onArrayStart(). */
+		ARRAY_END,		/*!< See IBSONObjectVisitor::onArrayEnd(). */
+		ELEMENT,		/*!< See IBSONObjectVisitor::onElement(). */
+		ELIDED,			/*!< See IBSONObjectVisitor::onElided(). The summary is available from getElision(). */
+		PARSE_END,		/*!< See IBSONObjectVisitor::onParseEnd(). */
+		DONE			/*!< The parse is complete, no further events. */
+	};
+
+private:
+	/*!
+	 * \brief Iteration state of one BSON object or BSON array being parsed.
+	 *
+	 * Frames are kept in a std::deque so the objects and elements referenced by the BSONParserStack items
+	 * remain at a fixed address while deeper frames are pushed and popped.
+	 */
+	struct Frame {
+		BSONParserStackItem::ItemType type;	/*!< OBJECT or ARRAY. */
+		BSONObj container;					/*!< The object, or the embedded object holding the array elements. */
+		BSONElement element;				/*!< The array element, ARRAY frames only. */
+		StringData key;						/*!< The key of this object or array. */
+		int elementIndex;					/*!< See BSONParserStackItem::elementIndex. */
+		int elementCount;					/*!< See BSONParserStackItem::elementCount. */
+		int arrayIndex;						/*!< See BSONParserStackItem::arrayIndex. */
+		int childIndex;						/*!< Index of the next child to visit. */
+		int childCount;						/*!< Count of the children. */
+		BSONPathFilter::Match match;		/*!< The path filter match of this object or array. */
+		bool keyed;							/*!< True if \ref key was pushed onto the cursor's path, i.e., the frame is an object element. */
+		vector<BSONElement> elements;		/*!< The object's selected elements in key order, OBJECT frames only. */
+		vector<BSONPathFilter::Match> matches;	/*!< The path filter match of each of \ref elements, only with a path filter. */
+		vector<int> order;					/*!< The indexes of \ref elements with the scalars first, only with --scalarfirst. */
+		BSONObjIterator nextElement;		/*!< The next element to visit, ARRAY frames only. */
+		BSONElement child;					/*!< Storage for the current scalar child. */
+
+		Frame(BSONParserStackItem::ItemType ptype, const BSONObj& pcontainer, const BSONElement& pelement, StringData pkey, int pelementIndex, int pelementCount, int parrayIndex,
+				BSONPathFilter::Match pmatch, bool pkeyed)
+			: type(ptype), container(pcontainer), element(pelement), key(pkey), elementIndex(pelementIndex), elementCount(pelementCount),
+			  arrayIndex(parrayIndex), childIndex(0), childCount(0), match(pmatch), keyed(pkeyed), nextElement(container) {}
+	};
+
+	BSONObj object;
+	bool countArrays;
+	const BSONPathFilter* pathFilter;
+	bool scalarFirst;
+	int maxDepth;
+	int maxArrayElems;
+	Event current;
+	bool dropPending;
+	deque<Frame> frames;
+	vector<StringData> path;	/*!< The keys of the open object elements, excluding array element indexes. Only maintained with a path filter. */
+	BSONParserStack stack;
+	BSONElision elision;		/*!< The summary of the last ELIDED event. */
+
+	void pushObject(const BSONObj& container, StringData key, int elementIndex, int elementCount, int arrayIndex, int arrayCount, BSONPathFilter::Match match, bool keyed);
+	void popFrame();
+	Event enter(Frame& parent, int elementIndex, int elementCount, int arrayIndex, int arrayCount, BSONPathFilter::Match match, bool keyed);
+	Event advance();
+
+public:
+	/*!
+	 * \brief Construct a cursor over a BSON Object producing every element in key order.
+	 * \param[in] pobject The BSON object to parse. The object's data must outlive the cursor.
+	 * \param[in] pcountArrays True to count the elements of each array, false to report BSONParserStackItem::ARRAY_COUNT_UNKNOWN. See IBSONObjectVisitor::isArrayCountRequired().
+	 */
+	BSONParseCursor(const BSONObj& pobject, bool pcountArrays = true)
+		: object(pobject), countArrays(pcountArrays), pathFilter(NULL), scalarFirst(false), maxDepth(0), maxArrayElems(0),
+		  current(INITIAL), dropPending(false), elision(BSONElision::DEPTH, BSONType::Object) {}
+
+	/*!
+	 * \brief Construct a cursor over a BSON Object configured by the command line parameters.
+	 * \param[in] pobject The BSON object to parse. The object's data must outlive the cursor.
+	 * \param[in] params The command line parameters supplying the parse options, i.e., the --include and --exclude path filter, --scalarfirst,
+	 * --max-depth and --max-array-elems.
+	 * \param[in] pcountArrays True to count the elements of each array, false to report BSONParserStackItem::ARRAY_COUNT_UNKNOWN. See IBSONObjectVisitor::isArrayCountRequired().
+	 */
+	BSONParseCursor(const BSONObj& pobject, const Parameters& params, bool pcountArrays = true)
+		: object(pobject), countArrays(pcountArrays), pathFilter(params.getPathFilter().isActive() ? &params.getPathFilter() : NULL),
+		  scalarFirst(params.isScalarFirst()), maxDepth(params.getMaxDepth()), maxArrayElems(params.getMaxArrayElems()),
+		  current(INITIAL), dropPending(false), elision(BSONElision::DEPTH, BSONType::Object) {}
+
+	virtual ~BSONParseCursor() {}
+
+	/*!
+	 * \brief Restart the cursor on a (possibly different) BSON object, retaining its internal storage.
+	 * \param[in] pobject The BSON object to parse. The object's data must outlive the cursor.
+	 */
+	void reset(const BSONObj& pobject) {
+		stack.clear();
+		frames.clear();
+		path.clear();
+		object = pobject;
+		current = INITIAL;
+		dropPending = false;
+	}
+
+	/*!
+	 * \brief Produce the next parse event.
+	 * \return The event, also available from event() until the following call. Returns DONE once the parse is complete.
+	 */
+	Event next();
+
+	/*!
+	 * \return The event produced by the last call to next().
+	 */
+	Event event() const {
+		return current;
+	}
+
+	/*!
+	 * \return The parse context of the current event. Empty for PARSE_START, PARSE_END and DONE.
+	 */
+	const BSONParserStack& getStack() const {
+		return stack;
+	}
+
+	/*!
+	 * \return The summary of the omitted elements of the current ELIDED event.
+	 */
+	const BSONElision& getElision() const {
+		return elision;
+	}
+
+	/*!
+	 * \brief Deliver the current event to a push style visitor.
+	 * \param[in] visitor The visitor to receive the event.
+	 */
+	void dispatch(IBSONObjectVisitor& visitor) const {
+		switch (current) {
+		case PARSE_START:	visitor.onParseStart(); break;
+		case OBJECT_START:	visitor.onObjectStart(stack); break;
+		case OBJECT_END:	visitor.onObjectEnd(stack); break;
+		case ARRAY_START:	visitor.onArrayStart(stack); break;
+		case ARRAY_END:		visitor.onArrayEnd(stack); break;
+		case ELEMENT:		visitor.onElement(stack); break;
+		case ELIDED:		visitor.onElided(stack, elision); break;
+		case PARSE_END:		visitor.onParseEnd(); break;
+		default: break;
+		}
+	}
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* BSONPARSECURSOR_HPP_ */
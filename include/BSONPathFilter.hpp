@@ -0,0 +1,124 @@
+/*!
+ * \file BSONPathFilter.hpp
+ * \brief BSON Path Include/Exclude Filter Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef BSONPATHFILTER_HPP_
+#define BSONPATHFILTER_HPP_
+
+#include <mongotype.hpp>
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class BSONPathFilter
+ * \brief Compiled set of --include and --exclude dotted path patterns.
+ *
+ * A pattern is a dotted key path, e.g., "payload.meta", where a "*" segment matches any single key, e.g., "payload.*.id".
+ * Array elements do not add a path segment, so "items.name" matches the "name" key of every object in the "items" array.
+ *
+ * A path is selected when:
+ * - It does not fall under any exclude pattern, and ...
+ * - There are no include patterns, or it falls under at least one include pattern.
+ *
+ * BSONObjectParser consults the filter before descending into an element, so unselected embedded objects and arrays
+ * are stepped over using their BSON length prefix without being parsed.
+ */
+
+class BSONPathFilter {
+public:
+	/*!
+	 * \enum Match The result of matching a path against the filter.
+	 */
+	enum Match {
+		EXCLUDED,	/*!< The path and everything below it are not selected. */
+		PARTIAL,	/*!< The path is not selected but it is an ancestor of an included path, so descend into it. */
+		INCLUDED	/*!< The path and everything below it, less any excluded paths, are selected. */
+	};
+
+private:
+	/*!
+	 * A compiled pattern: the dotted path split into its key segments.
+	 */
+	typedef vector<string> Pattern;
+
+	vector<Pattern> includes;
+	vector<Pattern> excludes;
+
+	static void compile(const string& patterns, vector<Pattern>& compiled);
+	static bool isPrefix(const Pattern& pattern, const vector<StringData>& path);
+	static bool isAncestor(const vector<StringData>& path, const Pattern& pattern);
+
+public:
+	BSONPathFilter() {}
+	virtual ~BSONPathFilter() {}
+
+	/*!
+	 * \brief Add include patterns.
+	 * \param[in] patterns One or more comma separated dotted path patterns.
+	 * \throws std::invalid_argument If a pattern is malformed.
+	 */
+	void addInclude(const string& patterns) {
+		compile(patterns, includes);
+	}
+
+	/*!
+	 * \brief Add exclude patterns.
+	 * \param[in] patterns One or more comma separated dotted path patterns.
+	 * \throws std::invalid_argument If a pattern is malformed.
+	 */
+	void addExclude(const string& patterns) {
+		compile(patterns, excludes);
+	}
+
+	/*!
+	 * \return True if any patterns have been added, i.e., if the filter can reject a path.
+	 */
+	bool isActive() const {
+		return !includes.empty() || !excludes.empty();
+	}
+
+	/*!
+	 * \brief Match a key path against the filter.
+	 * \param[in] path The keys of the path from the root object, excluding array element indexes.
+	 * \return The \ref Match result.
+	 */
+	Match match(const vector<StringData>& path) const;
+
+	/*!
+	 * \brief Path Filter Stream Output Operator.
+	 * \param[in] f The BSONPathFilter object to write to the output stream.
+	 */
+	OSTREAM_FRIEND(const BSONPathFilter& f);
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+#endif /* BSONPATHFILTER_HPP_ */
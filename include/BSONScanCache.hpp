@@ -0,0 +1,145 @@
+/*!
+ * \file BSONScanCache.hpp
+ * \brief Local Collection Scan Cache Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef BSONSCANCACHE_HPP_
+#define BSONSCANCACHE_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <mongotype.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class BSONScanCache
+ * \brief Local file copy of the documents returned by a collection scan.
+ *
+ * Enabled by --cache=<directory>. The cache file for a scan is named by a hash of the scan's identity, i.e., the server,
+ * the db.collection, the query and the projection. It holds a header followed by the scanned BSON documents back to back:
+ *
+ * | Field    | Content                                                   |
+ * |----------|-----------------------------------------------------------|
+ * | magic    | "MONGOTYPECACHE01"                                        |
+ * | key      | int32 length + the scan identity, guarding against hash collisions |
+ * | count    | int64 collection document count at scan time              |
+ * | max _id  | int32 length + the BSON element of the greatest _id       |
+ * | docs     | The BSON documents                                        |
+ *
+ * A later scan with the same identity is served by memory mapping the file if the collection's current count and
+ * greatest _id, both cheap to query, still match the header. Otherwise the scan goes to the server and the file is
+ * rewritten as the documents arrive.
+ */
+
+class BSONScanCache {
+	string path;
+	string key;
+
+	// Read state.
+	int fd;
+	void* map;
+	size_t mapLength;
+	const char* nextDoc;
+	const char* endDoc;
+
+	// Write state.
+	unique_ptr<ofstream> out;
+	string tempPath;
+
+	void close();
+
+public:
+	/*!
+	 * \param[in] dir The cache directory.
+	 * \param[in] pkey The identity of the scan, i.e., the server, db.collection, query and projection.
+	 */
+	BSONScanCache(const string& dir, const string& pkey);
+	virtual ~BSONScanCache();
+
+	/*!
+	 * \brief Map the cache file if it is present and fresh.
+	 * \param[in] count The current document count of the collection.
+	 * \param[in] maxId The current greatest _id element of the collection, EOO if the collection is empty.
+	 * \return True if the cache file is fresh and mapped, false if the scan must go to the server.
+	 */
+	bool open(long long count, const BSONElement& maxId);
+
+	/*!
+	 * \return True if another mapped document remains.
+	 */
+	bool more() const {
+		return nextDoc < endDoc;
+	}
+
+	/*!
+	 * \return The next mapped document. The document references the mapping and is valid for the lifetime of the cache object.
+	 * \throws std::runtime_error If the document's length prefix overruns the file.
+	 */
+	BSONObj next();
+
+	/*!
+	 * \brief Begin rewriting the cache file.
+	 * \param[in] count The document count of the collection.
+	 * \param[in] maxId The greatest _id element of the collection, EOO if the collection is empty.
+	 * \throws std::runtime_error If the file cannot be created.
+	 */
+	void create(long long count, const BSONElement& maxId);
+
+	/*!
+	 * \brief Append a scanned document to the file being written.
+	 * \param[in] object The document.
+	 */
+	void append(const BSONObj& object) {
+		out->write(object.objdata(), object.objsize());
+	}
+
+	/*!
+	 * \brief Complete the file being written, replacing any previous cache file.
+	 * \throws std::runtime_error If the file cannot be written.
+	 */
+	void commit();
+
+	/*!
+	 * \return The cache file path.
+	 */
+	const string& getPath() const {
+		return path;
+	}
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* BSONSCANCACHE_HPP_ */
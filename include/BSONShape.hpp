@@ -0,0 +1,94 @@
+/*!
+ * \file BSONShape.hpp
+ * \brief BSON Document Shape Fingerprint Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef BSONSHAPE_HPP_
+#define BSONSHAPE_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#include <mongotype.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class BSONShape
+ * \brief Structural fingerprint of a BSON document.
+ *
+ * Two documents have the same shape if they have the same keys, with the same types, in the same order, at every
+ * nesting level. Array lengths are part of the shape since array indexes are keys. Values are not. Documents of one
+ * shape produce the same parse event sequence, so a renderer may compute the value independent parts of its output,
+ * i.e., paths, keys and type strings, once per shape. See BSONDotNotationDump.
+ */
+
+class BSONShape {
+	static const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+	static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+	static uint64_t hash(uint64_t h, const char* p, size_t n) {
+		for (size_t i = 0; i < n; i++) {
+			h = (h ^ (unsigned char)p[i]) * FNV_PRIME;
+		}
+		return h;
+	}
+
+	static uint64_t hash(uint64_t h, const BSONObj& object) {
+		BSONObjIterator i(object);
+		while (i.more()) {
+			const BSONElement e(i.next());
+			h = hash(h, e.rawdata(), e.fieldNameSize() + 1); // The type byte and the NUL terminated key.
+			if (e.type() == BSONType::Object || e.type() == BSONType::Array) {
+				h = hash(h, e.embeddedObject());
+			}
+		}
+		return (h ^ 0xFF) * FNV_PRIME; // Close the object so { a:{ b }, c } and { a:{ b, c } } differ.
+	}
+
+public:
+	/*!
+	 * \param[in] object The BSON document.
+	 * \return The 64 bit FNV-1a hash of the document's structure.
+	 */
+	static uint64_t fingerprint(const BSONObj& object) {
+		return hash(FNV_OFFSET, object);
+	}
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* BSONSHAPE_HPP_ */
@@ -0,0 +1,223 @@
+/*!
+ * \file BSONTableDump.hpp
+ * \brief Flattened CSV and TSV Table Dump Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef BSONTABLEDUMP_HPP_
+#define BSONTABLEDUMP_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <unordered_map>
+
+#include <mongotype.hpp>
+#include <Parameters.hpp>
+#include <IBSONRenderer.hpp>
+#include <BSONObjectParser.hpp>
+#include <BSONDotPath.hpp>
+#include <OutputSink.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class BSONTableDump
+ * \brief Flattened BSON table dump: one header line, then one delimited row per document.
+ *
+ * The columns are the dotted paths of the scalar elements, object keys and array indexes alike, e.g., "sub.a.deep" or
+ * "arr.2.z". They are either the --columns list, or the paths of the first --sample documents in the order first
+ * seen, in which case the cells of the sampled documents are held, and their rows written as the next document
+ * begins or at end(), once the columns are known. Rows are built from the parse events alone, and no document is
+ * parsed twice, so the style may be one of several --outputs fed by a single parse. Each row has a cell for every
+ * column, in the column order, left empty for paths missing from the document, and paths that are not columns are
+ * not output. Objects and arrays summarized per --max-depth are a cell of their summary text, while the array
+ * elements omitted per --max-array-elems are not output.
+ *
+ * The CSV cells are quoted per RFC 4180 when they contain a comma, quote or line break. The TSV cells escape a tab,
+ * line break or backslash with a backslash. Strings are their text, untruncated, numbers and booleans their JSON text,
+ * dates ISO-8601, null and undefined an empty cell, and other values their mongo shell text, e.g., "ObjectId('...')".
+ *
+ * \see IBSONObjectVisitor, BSONObjectParser, BSONDotPath
+ */
+
+class BSONTableDump : virtual public IBSONRenderer, virtual protected IBSONObjectVisitor {
+	Parameters& params;
+	char delimiter;			/*!< ',' for CSV, '\t' for TSV. */
+	BSONDotPath path;		/*!< The column path of the innermost object or array. */
+	BSONLazyObjectParser objectParser; // Parses every rendered document, reusing its buffers.
+	OutputSink* out; // The sink written to, see setOutputSink().
+
+	vector<string> columns;
+	unordered_map<string, size_t> columnIndex;	/*!< The index in \ref columns of each column path. */
+	bool sampling;			/*!< True while the columns are collected from the sampled documents. */
+
+	/*!
+	 * \brief A held cell of a sampled document's row.
+	 */
+	struct SampleCell {
+		size_t column;
+		pair<size_t, size_t> range;	/*!< The start and end of the cell in \ref cells. */
+	};
+	vector<SampleCell> sampleCells;	/*!< The cells of the sampled documents' rows, row after row. */
+	vector<size_t> sampleRows;		/*!< The end in \ref sampleCells of each sampled document's row. */
+
+	OutputSink cells;		/*!< The encoded cells of the row being built, and while sampling those of the held rows. */
+	vector<pair<size_t, size_t>> cellRanges;	/*!< The start and end in \ref cells of each column's cell, empty if equal. */
+	vector<size_t> filled;	/*!< The columns with a cell in the row being built. */
+	OutputSink value;		/*!< The unencoded text of one value. */
+
+	size_t addColumn(const string& column);
+	void setCell(size_t column, const char* p, size_t n);
+	void writeField(OutputSink& sink, const char* p, size_t n);
+	void setValueCell(size_t column, const BSONElement& element);
+	void writeHeader();
+	void writeCells();
+	void writeRow();
+	void holdRow();
+	void endSampling();
+
+	/*!
+	 * \brief Append an object, array or element key to \ref path.
+	 */
+	void pushKey(const BSONParserStack& stack) {
+		bool nested = !path.isRoot();
+		path.push();
+		if (nested) {
+			path += '.';
+		}
+		path += stack.top().getKey();
+	}
+
+protected: // IBSONObjectVisitor overrides.
+
+	virtual void onParseStart() { }
+
+	virtual void onParseEnd() { }
+
+	virtual void onObjectStart(const BSONParserStack& stack) {
+		if (stack.depth() > 1) {
+			pushKey(stack);
+		}
+	}
+
+	virtual void onObjectEnd(const BSONParserStack& stack) {
+		if (stack.depth() > 1) {
+			path.pop();
+		} else if (sampling) {
+			holdRow();
+		} else {
+			writeRow();
+		}
+	}
+
+	virtual void onArrayStart(const BSONParserStack& stack) {
+		pushKey(stack);
+	}
+
+	virtual void onArrayEnd(const BSONParserStack& stack) {
+		path.pop();
+	}
+
+	virtual void onElement(const BSONParserStack& stack);
+
+	virtual void onElided(const BSONParserStack& stack, const BSONElision& elision);
+
+	virtual bool isArrayCountRequired() const {
+		return false; // The array count is never output.
+	}
+
+public: // User Interface
+
+	/*!
+	 * \brief Construct a BSON table dumper.
+	 * \param[in] pparams The command line parameters object, giving the --columns or the --sample count.
+	 * \param[in] pdelimiter ',' for CSV or '\t' for TSV.
+	 */
+	BSONTableDump(Parameters& pparams, char pdelimiter);
+
+	virtual ~BSONTableDump() {};
+
+	/*
+	 * \param[in] sink The output sink to which the object(s) are rendered.
+	 */
+	virtual void setOutputSink(OutputSink& sink) {
+		out = &sink;
+	}
+
+	/*
+	 * \param[in] prefix Unused, a table has no prefix.
+	 */
+	virtual void begin(const char* prefix) {
+		if (!sampling) {
+			writeHeader();
+		}
+	}
+
+	/*
+	 * \param[in] suffix Unused, a table has no suffix.
+	 */
+	virtual void end(const char* suffix) {
+		if (sampling) { // Fewer documents than the --sample count.
+			endSampling();
+		}
+	}
+
+	virtual void render(const BSONObj& object, int docIndex, int docCount) {
+		beginDocument(docIndex, docCount);
+		objectParser.parse(object); // Collect the document's columns, or write its row.
+	}
+
+	virtual void renderBatch(const BSONObj* objects, int count, int firstIndex, int docCount) {
+		renderEach(*this, objects, count, firstIndex, docCount);
+		flush();
+	}
+
+	virtual void flush() {
+		out->flush();
+	}
+
+	virtual void beginDocument(int docIndex, int docCount) {
+		if (sampling && (int)sampleRows.size() >= params.getSampleSize()) {
+			endSampling();
+		}
+	}
+
+	virtual IBSONObjectVisitor& getVisitor() {
+		return *this;
+	}
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* BSONTABLEDUMP_HPP_ */
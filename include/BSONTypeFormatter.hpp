@@ -75,6 +75,41 @@ public:
 	}
 };
 
+/*!
+ * \brief Per renderer table of BSONTypeFormatter strings.
+ *
+ * The type string depends only on the BSON type and the --type mask, so each is formatted once and reused.
+ */
+
+class BSONTypeFormatCache {
+	Parameters& params;
+	string strings[256];
+	bool cached[256];
+
+public:
+
+	/*!
+	 * \brief Construct an empty type string table.
+	 * \param[in] pparams The command line parameters object.
+	 */
+	BSONTypeFormatCache(Parameters& pparams) : params(pparams) {
+		memset(cached, 0, sizeof(cached));
+	}
+
+	/*!
+	 * \param[in] e The BSONElement whose type string will be looked up.
+	 * \return The string BSONTypeFormatter::to_string() returns for the element.
+	 */
+	const string& get(const BSONElement& e) {
+		unsigned char type = (unsigned char)e.type();
+		if (!cached[type]) {
+			strings[type] = BSONTypeFormatter(params, e).to_string();
+			cached[type] = true;
+		}
+		return strings[type];
+	}
+};
+
 } /* namespace mongotype */
 
 #endif /* BSONTYPEFORMATTER_HPP_ */
@@ -0,0 +1,118 @@
+/*!
+ * \file BSONValidator.hpp
+ * \brief BSON Document Validator Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef BSONVALIDATOR_HPP_
+#define BSONVALIDATOR_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <mongotype.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class BSONValidator
+ * \brief Structural validation of BSON documents that did not come from a live server, i.e., --cache files.
+ *
+ * Checks that every length is in bounds, every object is terminated, every element type is known, and every key and
+ * string value is NUL terminated, well formed UTF-8. BSONObjectParser and the renderers assume all of the above,
+ * so an unchecked corrupt document may read out of bounds. Documents received from the server are trusted, as are
+ * cached documents when --trusted is given.
+ *
+ * Keys and strings are overwhelmingly ASCII, so UTF-8 validation tests 32 (AVX2) or 16 (SSE2) bytes at a time for
+ * the high bit and only decodes multi-byte sequences with scalar code. Without SSE2 the whole check is scalar.
+ */
+
+class BSONValidator {
+	const char* base;
+	const char* error;
+	size_t errorOffset;
+	int maxDepth;
+
+	bool fail(const char* p, const char* reason) {
+		error = reason;
+		errorOffset = p - base;
+		return false;
+	}
+
+	bool validateObject(const char* p, const char* end, int depth);
+	bool validateCString(const char*& p, const char* end);
+	bool validateString(const char*& p, const char* end);
+
+public:
+	/*!
+	 * \param[in] pmaxDepth The deepest nesting of objects and arrays accepted.
+	 */
+	BSONValidator(int pmaxDepth = 200) : base(NULL), error(NULL), errorOffset(0), maxDepth(pmaxDepth) {}
+	virtual ~BSONValidator() {}
+
+	/*!
+	 * \brief Validate one BSON document.
+	 * \param[in] data The document.
+	 * \param[in] available The count of bytes readable at data, the document's length must not exceed it.
+	 * \return True if the document is valid, otherwise false with the reason available from getError().
+	 */
+	bool validate(const char* data, size_t available);
+
+	/*!
+	 * \return The reason the last validate() failed, or NULL.
+	 */
+	const char* getError() const {
+		return error;
+	}
+
+	/*!
+	 * \return The document offset of the byte at which the last validate() failed.
+	 */
+	size_t getErrorOffset() const {
+		return errorOffset;
+	}
+
+	/*!
+	 * \return The length of the longest prefix of the bytes that is 7 bit ASCII.
+	 */
+	static size_t asciiPrefix(const unsigned char* p, size_t n);
+
+	/*!
+	 * \return True if the bytes are well formed UTF-8 per RFC 3629, i.e., no overlong forms, surrogates or code points over U+10FFFF.
+	 */
+	static bool isValidUTF8(const char* p, size_t n);
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* BSONVALIDATOR_HPP_ */
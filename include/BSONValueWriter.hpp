@@ -0,0 +1,186 @@
+/*!
+ * \file BSONValueWriter.hpp
+ * \brief Bounded Memory BSON Value Output Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef BSONVALUEWRITER_HPP_
+#define BSONVALUEWRITER_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <cmath>
+
+#include <mongotype.hpp>
+#include <OutputSink.hpp>
+#include <JSONStringEncoder.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class BSONValueWriter
+ * \brief Writes BSON element values to an output sink in pieces of at most a fixed buffer size.
+ *
+ * BSONElement::toString() builds the whole value text in memory and, unless asked for the full value, truncates
+ * strings and binary data. String and BinData values are instead written untruncated straight from the BSON bytes,
+ * strings escaped by JSONStringEncoder in runs and binary data hex encoded through the buffer, so that the memory
+ * used per value is bounded by the --bufsize buffer rather than by the value's size. Doubles are written by
+ * formatDouble(). Other types, whose text is small, are written via BSONElement::toString().
+ */
+
+class BSONValueWriter {
+	vector<char> buffer;
+
+public:
+	/*!
+	 * The size of the buffer passed to formatDouble().
+	 */
+	static const size_t DOUBLE_BUFFER_SIZE = 32;
+
+	/*!
+	 * \brief Format a double with the fewest significant digits that read back as the same double.
+	 *
+	 * The text is that of printf's %.<i>N</i>g, where <i>N</i> is the greater of 15 and the shortest round-trip digit
+	 * count, followed by ".0" if it would otherwise read as an integer, e.g., "5.0", "0.1", "0.30000000000000004",
+	 * "1e+300". The digits come from std::to_chars when built as C++17, otherwise from the first of %.15g, %.16g
+	 * and %.17g (from %.1g for subnormals) that reads back as the same double; both produce the same text.
+	 * \param[in] value The double.
+	 * \param[out] buf The text, at least DOUBLE_BUFFER_SIZE bytes, not NUL terminated.
+	 * \return The length of the text.
+	 */
+	static size_t formatDouble(double value, char* buf);
+
+	/*!
+	 * \brief Write a double formatted by formatDouble().
+	 * \param[in] sink The output sink.
+	 * \param[in] value The double.
+	 */
+	static void writeDouble(OutputSink& sink, double value) {
+		char buf[DOUBLE_BUFFER_SIZE];
+		sink.write(buf, formatDouble(value, buf));
+	}
+
+	/*!
+	 * \brief Write an element in the format of BSONElement::toString(includeFieldName, false), i.e., with long values abbreviated, but doubles formatted by formatDouble().
+	 * \param[in] sink The output sink.
+	 * \param[in] e The element.
+	 * \param[in] includeFieldName True to prefix the value with the element's key and ": ".
+	 */
+	static void writeAbbreviated(OutputSink& sink, const BSONElement& e, bool includeFieldName) {
+		if (e.type() == BSONType::NumberDouble) {
+			if (includeFieldName) {
+				sink << e.fieldNameStringData() << ": ";
+			}
+			writeDouble(sink, e.number());
+		} else {
+			sink << e.toString(includeFieldName, false);
+		}
+	}
+
+	/*!
+	 * \param[in] bufferSize The size of the piece buffer, i.e., --bufsize.
+	 */
+	BSONValueWriter(size_t bufferSize) : buffer(std::max(bufferSize, (size_t)64)) {}
+	virtual ~BSONValueWriter() {}
+
+	/*!
+	 * \brief Write bytes as upper case hexadecimal, encoding a buffer's worth at a time.
+	 * \param[in] sink The output sink.
+	 * \param[in] p The bytes.
+	 * \param[in] n The count of bytes.
+	 */
+	void writeHex(OutputSink& sink, const char* p, size_t n) {
+		static const char HEX[] = "0123456789ABCDEF";
+		const size_t perPiece = buffer.size() / 2;
+		while (n > 0) {
+			size_t piece = std::min(n, perPiece);
+			char* out = &buffer[0];
+			for (size_t i = 0; i < piece; i++) {
+				unsigned char c = p[i];
+				*out++ = HEX[c >> 4];
+				*out++ = HEX[c & 0xF];
+			}
+			sink.write(&buffer[0], piece * 2);
+			p += piece;
+			n -= piece;
+		}
+	}
+
+	/*!
+	 * \brief Write an element's value as a JSON value.
+	 *
+	 * Strings are written as JSON strings, and numbers, booleans and null as themselves. Values JSON has no literal for,
+	 * e.g., ObjectId, Date, BinData, or a NaN or infinite double, are written as a JSON string of their mongo shell text,
+	 * e.g., "ObjectId('...')" or "BinData(0, 0A1B)".
+	 * \param[in] sink The output sink.
+	 * \param[in] e The element.
+	 */
+	void write(OutputSink& sink, const BSONElement& e) {
+		switch (e.type()) {
+		case BSONType::String:
+			JSONStringEncoder::writeQuoted(sink, e.valuestr(), e.valuestrsize() - 1);
+			break;
+		case BSONType::BinData:
+			{
+				int length;
+				const char* data = e.binDataClean(length);
+				sink << "\"BinData(" << (int)e.binDataType() << ", ";
+				writeHex(sink, data, length);
+				sink << ")\"";
+			}
+			break;
+		case BSONType::NumberDouble:
+			if (std::isfinite(e.number())) {
+				writeDouble(sink, e.number());
+			} else {
+				char buf[DOUBLE_BUFFER_SIZE];
+				JSONStringEncoder::writeQuoted(sink, buf, formatDouble(e.number(), buf));
+			}
+			break;
+		case BSONType::NumberInt:
+		case BSONType::NumberLong:
+		case BSONType::Bool:
+		case BSONType::jstNULL:
+			sink << e.toString(false, false);
+			break;
+		default:
+			JSONStringEncoder::writeQuoted(sink, e.toString(false, true));
+			break;
+		}
+	}
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* BSONVALUEWRITER_HPP_ */
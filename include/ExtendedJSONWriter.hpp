@@ -0,0 +1,172 @@
+/*!
+ * \file ExtendedJSONWriter.hpp
+ * \brief MongoDB Extended JSON v2 Value Output Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef EXTENDEDJSONWRITER_HPP_
+#define EXTENDEDJSONWRITER_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <mongotype.hpp>
+#include <OutputSink.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class ExtendedJSONWriter
+ * \brief Writes BSON element values as MongoDB Extended JSON v2.
+ *
+ * Values are decoded straight from the element's BSON bytes, never via BSONElement::toString(), so every BSON type
+ * keeps its identity and the output may be reloaded, e.g., by mongoimport, with the same value types:
+ *
+ * | BSON type    | Canonical                                           | Relaxed, where different                     |
+ * |--------------|-----------------------------------------------------|----------------------------------------------|
+ * | Double       | {"$numberDouble": "1.5"}                            | 1.5, non-finite values as canonical          |
+ * | Int32        | {"$numberInt": "42"}                                | 42                                           |
+ * | Int64        | {"$numberLong": "42"}                               | 42                                           |
+ * | Decimal128   | {"$numberDecimal": "1.50"}                          |                                              |
+ * | Date         | {"$date": {"$numberLong": "1600000000123"}}         | {"$date": "2020-09-13T12:26:40.123Z"} for years 1970 to 9999 |
+ * | ObjectId     | {"$oid": "5f1d7a0e8b3c4a1e2d3f4a5b"}                |                                              |
+ * | Binary       | {"$binary": {"base64": "AQL/", "subType": "00"}}    |                                              |
+ * | Timestamp    | {"$timestamp": {"t": 1, "i": 2}}                    |                                              |
+ * | Regex        | {"$regularExpression": {"pattern": "^a", "options": "i"}} |                                        |
+ * | Code         | {"$code": "..."}, with "$scope" for code with scope |                                              |
+ * | Others       | {"$symbol": ...}, {"$dbPointer": ...}, {"$undefined": true}, {"$minKey": 1}, {"$maxKey": 1} |      |
+ *
+ * Strings, booleans and null are plain JSON. Numbers use BSONValueWriter::formatDouble() and strings JSONStringEncoder.
+ *
+ * Only the values are written here, the documents around them are rendered by JSONDump from the BSONObjectParser
+ * events. The reloaded documents are therefore those of the parse, not the original BSON: the keys of every object are
+ * in key order, only the first of any repeated keys is kept, and --scalarfirst, --include, --exclude, --max-depth and
+ * --max-array-elems apply. The objects written by writeObject(), e.g., a code scope, are the exception and keep their
+ * BSON order.
+ *
+ * \see https://github.com/mongodb/specifications/blob/master/source/extended-json.rst
+ */
+
+class ExtendedJSONWriter {
+public:
+	/*!
+	 * \enum Mode The Extended JSON v2 format.
+	 */
+	enum Mode {
+		CANONICAL,	/*!< Every type is preserved, numbers included. */
+		RELAXED		/*!< Numbers and dates in the years 1970 to 9999 are written in their natural JSON form. */
+	};
+
+	/*!
+	 * The BSON type code of Decimal128, which predates some driver versions' BSONType.
+	 */
+	static const int NUMBER_DECIMAL = 19;
+
+	/*!
+	 * The size of the buffer passed to formatDecimal128().
+	 */
+	static const size_t DECIMAL128_BUFFER_SIZE = 48;
+
+	/*!
+	 * The size of the buffer passed to formatISODate().
+	 */
+	static const size_t DATE_BUFFER_SIZE = 32;
+
+	/*!
+	 * The milliseconds since the epoch of 9999-12-31T23:59:59.999Z, the last date formatted by formatISODate().
+	 */
+	static const long long MAX_ISO_DATE = 253402300799999LL;
+
+private:
+	Mode mode;
+
+	void writeCanonicalDouble(OutputSink& sink, double value);
+	void writeDate(OutputSink& sink, long long millis);
+
+public:
+	/*!
+	 * \param[in] pmode The format.
+	 */
+	ExtendedJSONWriter(Mode pmode) : mode(pmode) {}
+	virtual ~ExtendedJSONWriter() {}
+
+	/*!
+	 * \return The format.
+	 */
+	Mode getMode() const {
+		return mode;
+	}
+
+	/*!
+	 * \brief Write an element's value.
+	 * \param[in] sink The output sink.
+	 * \param[in] e The element, of any type. Objects and arrays are written by writeObject().
+	 */
+	void write(OutputSink& sink, const BSONElement& e);
+
+	/*!
+	 * \brief Write an object, or an array as an array, on one line, in BSON key order.
+	 * \param[in] sink The output sink.
+	 * \param[in] object The object.
+	 * \param[in] isArray True to write the object's values as a JSON array.
+	 */
+	void writeObject(OutputSink& sink, const BSONObj& object, bool isArray);
+
+	/*!
+	 * \brief Write bytes in base64 per RFC 4648, with padding.
+	 * \param[in] sink The output sink.
+	 * \param[in] p The bytes.
+	 * \param[in] n The count of bytes.
+	 */
+	static void writeBase64(OutputSink& sink, const char* p, size_t n);
+
+	/*!
+	 * \brief Format an IEEE 754-2008 decimal128 value, binary integer decimal encoded, as the Decimal128 specification's string.
+	 * \param[in] bytes The 16 little endian value bytes.
+	 * \param[out] buf The text, at least DECIMAL128_BUFFER_SIZE bytes, not NUL terminated.
+	 * \return The length of the text.
+	 */
+	static size_t formatDecimal128(const char* bytes, char* buf);
+
+	/*!
+	 * \brief Format a BSON date in the years 1970 to 9999 as ISO-8601 UTC with milliseconds, e.g., "2020-09-13T12:26:40.123Z".
+	 * \param[in] millis The milliseconds since the epoch, from 0 to MAX_ISO_DATE.
+	 * \param[out] buf The text, at least DATE_BUFFER_SIZE bytes.
+	 * \return The length of the text.
+	 */
+	static size_t formatISODate(long long millis, char* buf);
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* EXTENDEDJSONWRITER_HPP_ */
@@ -8,20 +8,68 @@
 #ifndef IBSONRENDERER_HPP_
 #define IBSONRENDERER_HPP_
 
-#include <ostream>
 #include <memory>
 
+#include <OutputSink.hpp>
+#include <BSONObjectParser.hpp>
+
 namespace mongotype {
 
 class IBSONRenderer {
 public:
 	virtual ~IBSONRenderer() {};
-	virtual void setOutputStream(std::ostream& os) = 0;
+	virtual void setOutputSink(OutputSink& sink) = 0;
 	virtual void begin(const char* prefix) = 0;
 	virtual void end(const char* suffix) = 0;
 	virtual void render(const BSONObj& object, int docIndex, int docCount) = 0;
+
+	/*
+	 * Render a contiguous batch of documents, e.g., a cursor batch or a cache file chunk, then flush().
+	 * \param[in] objects The documents.
+	 * \param[in] count The count of documents.
+	 * \param[in] firstIndex The zero based index of the first document.
+	 * \param[in] docCount The count of documents in the whole scan.
+	 */
+	virtual void renderBatch(const BSONObj* objects, int count, int firstIndex, int docCount) = 0;
+
+	/*
+	 * Write any output buffered by the renderer to its output file(s).
+	 */
+	virtual void flush() = 0;
+
+	/*
+	 * Output the text preceding a document, i.e., the first half of render(), for renderers driven by an external parser.
+	 * \param[in] docIndex The zero based index of the document.
+	 * \param[in] docCount The count of documents.
+	 */
+	virtual void beginDocument(int docIndex, int docCount) = 0;
+
+	/*
+	 * \return The visitor that renders the parse events of a document, i.e., the second half of render().
+	 */
+	virtual IBSONObjectVisitor& getVisitor() = 0;
 };
 
+/*
+ * Render each document of a batch with a statically bound call to the renderer's own render(), prefetching the next document's bytes.
+ * Shared by the IBSONRenderer::renderBatch() implementations.
+ * \param[in] renderer The renderer, of its most derived type.
+ * \param[in] objects The documents.
+ * \param[in] count The count of documents.
+ * \param[in] firstIndex The zero based index of the first document.
+ * \param[in] docCount The count of documents in the whole scan.
+ */
+template <class R> void renderEach(R& renderer, const BSONObj* objects, int count, int firstIndex, int docCount) {
+	for (int i = 0; i < count; i++) {
+#if defined(__GNUC__)
+		if (i + 1 < count) {
+			__builtin_prefetch(objects[i + 1].objdata());
+		}
+#endif
+		renderer.R::render(objects[i], firstIndex + i, docCount);
+	}
+}
+
 } /* namespace mongotype */
 
 #endif /* IBSONRENDERER_HPP_ */
@@ -0,0 +1,101 @@
+/*!
+ * \file IndentTable.hpp
+ * \brief Precomputed Line Indentation Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef INDENTTABLE_HPP_
+#define INDENTTABLE_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <mongotype.hpp>
+#include <OutputSink.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class IndentTable
+ * \brief A newline followed by the indent string repeated for the deepest level seen so far.
+ *
+ * The start of a line at any level is a prefix of the one buffer, written with a single OutputSink::write(). The
+ * buffer only grows, doubling its levels, when a deeper level is first written, so writing a line start does not
+ * allocate once the document depth is reached.
+ */
+
+class IndentTable {
+	string indentStr;
+	string lines;	/*!< "\n" followed by indentStr repeated \ref levels times. */
+	int levels;
+
+	void grow(int level) {
+		levels = std::max(level, levels * 2);
+		lines.reserve(1 + levels * indentStr.size());
+		while ((int)lines.size() < 1 + levels * (int)indentStr.size()) {
+			lines += indentStr;
+		}
+	}
+
+public:
+	/*!
+	 * \param[in] pindentStr The string repeated once per indent level.
+	 * \param[in] initialLevels The count of levels precomputed.
+	 */
+	IndentTable(const string& pindentStr, int initialLevels = 32) : indentStr(pindentStr), lines("\n"), levels(0) {
+		grow(initialLevels);
+	}
+
+	/*!
+	 * \brief Write a newline and the indentation of a level.
+	 * \param[in] sink The output sink.
+	 * \param[in] level The indent level.
+	 */
+	void writeLine(OutputSink& sink, int level) {
+		if (level > levels) {
+			grow(level);
+		}
+		sink.write(lines.data(), 1 + level * indentStr.size());
+	}
+
+	/*!
+	 * \return The string repeated once per indent level.
+	 */
+	const string& getIndentStr() const {
+		return indentStr;
+	}
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* INDENTTABLE_HPP_ */
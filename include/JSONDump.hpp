@@ -34,32 +34,46 @@
 #include <Parameters.hpp>
 #include <IBSONRenderer.hpp>
 #include <BSONObjectParser.hpp>
+#include <BSONValueWriter.hpp>
+#include <JSONStringEncoder.hpp>
+#include <IndentTable.hpp>
+#include <ExtendedJSONWriter.hpp>
+#include <BSONEventTape.hpp>
 
 namespace mongotype {
 
 /*!
  * \brief BSON -> JSON Dump
  *
- * Provides an std::ostream comparable output operator for dumping a JSON representation of the given BSON object. JSONDump implements interface IBSONObjectVisitor and
+ * Provides an output operator for dumping a JSON representation of the given BSON object. JSONDump implements interface IBSONObjectVisitor and
  * uses the BSON object parsing events to output the BSON object's JSON representation.
  *
- * \see IBSONObjectVisitor, BSONObjectParser, IBSONRenderer
+ * The documents are either indented elements of one top-level JSON array, or, line delimited, each document on a line
+ * of its own with no whitespace and nothing shared with the other documents, i.e., NDJSON.
+ *
+ * A document may also be rendered from its BSONEventTape by renderTape(), which walks the recorded events in a loop of its own.
+ *
+ * \see IBSONObjectVisitor, BSONObjectParser, IBSONRenderer, IBSONTapeRenderer
  */
 
-class JSONDump : virtual public IBSONRenderer, virtual protected IBSONObjectVisitor {
+class JSONDump : virtual public IBSONRenderer, virtual public IBSONTapeRenderer, virtual protected IBSONObjectVisitor {
 
 	Parameters& params;
-	string indentStr;
+	IndentTable indent;
+	BSONValueWriter valueWriter;
+	unique_ptr<ExtendedJSONWriter> extendedWriter; // Writes the values as Extended JSON v2 when set, see the constructor.
+	bool lineDelimited; // One unindented document per line, see the constructor.
 
-	function<ostream&()> getOStream; // std::function required to store a closure.
+	BSONLazyObjectParser objectParser; // Parses every rendered document, reusing its buffers.
+	OutputSink* out; // The sink written to, see setOutputSink().
 
 	// Output Helper Functions
 	// tstr functions centralize token output primarily for debugging purposes.
 	// istr emit a carriage return, indentation whitespace, and a token
 
 	void tstr(const char* token) {
-		getOStream() << token;
-		if (params.isDebug()) getOStream().flush(); // "Token Buffering" on debug.
+		*out << token;
+		if (params.isDebug()) out->flush(); // "Token Buffering" on debug.
 	}
 
 	void tstr(string& token) {
@@ -67,14 +81,10 @@ class JSONDump : virtual public IBSONRenderer, virtual protected IBSONObjectVisi
 	}
 
 	void istr(const char* token, int level) {
-		const string cr("\n");
-		string indent;
-		indent.reserve(1024);
-		for (int i=0; i < level; i++) {
-			indent += indentStr;
+		if (!lineDelimited) {
+			indent.writeLine(*out, level); // The newline and indentation as one slice of the precomputed table.
 		}
-		string s(cr + indent + token);
-		tstr(s);
+		tstr(token);
 	}
 
 	void istr(string& token, int level) {
@@ -84,43 +94,74 @@ class JSONDump : virtual public IBSONRenderer, virtual protected IBSONObjectVisi
 	/**
 	 * Emit a comma.
 	 */
-	void emitComma(const BSONParserStack& stack) {
-		const int ARRAY_PARENT_OFFSET = 2;
-		if (stack.depth() >= ARRAY_PARENT_OFFSET) {
-			const BSONParserStackItem& parent = stack.item(-ARRAY_PARENT_OFFSET);
-			bool parentIsNotArray = parent.getType() != BSONParserStackItem::ItemType::ARRAY;
-			//if (stack.top().getElementIndex() > 0 && parentIsNotArray) {
-			if (stack.top().getElementIndex() > 0 && (parentIsNotArray || stack.top().getArrayIndex() > 0)) {
-				tstr(",");
-			}
+	void emitComma(int depth, bool inArray, int elementIndex, int arrayIndex) {
+		// An array element carries the element index of its array, so follows a sibling only if its array index is non-zero.
+		if (depth > 1 && (inArray ? arrayIndex > 0 : elementIndex > 0)) {
+			tstr(",");
 		}
 	}
 
-	void emitKey(const BSONParserStack& stack) {
-		const int ARRAY_PARENT_OFFSET = 2;
-		bool parentIsNotArray = true;
-		if (stack.depth() >= ARRAY_PARENT_OFFSET) {
-			const BSONParserStackItem& parent = stack.item(-ARRAY_PARENT_OFFSET);
-			parentIsNotArray = parent.getType() != BSONParserStackItem::ItemType::ARRAY;
-		}
-		string s;
-		if (stack.depth() > 1 && parentIsNotArray) {
-			s += "\"";
-			s += stack.top().getKey();
-			s += "\" : ";
+	void emitKey(int depth, bool inArray, StringData key) {
+		istr("", depth);
+		if (depth > 1 && !inArray) {
+			JSONStringEncoder::writeQuoted(*out, key);
+			tstr(lineDelimited ? ":" : " : ");
 		}
-		istr(s, stack.depth());
 	}
 
 	/**
 	 * Emit a comma and/or object label based on output state.
 	 */
 	void nextLine(const BSONParserStack& stack) {
-		emitComma(stack);
+		const BSONParserStackItem& top = stack.top();
+		const bool inArray = stack.depth() > 1 && stack.item(-2).getType() == BSONParserStackItem::ItemType::ARRAY;
+		emitComma(stack.depth(), inArray, top.getElementIndex(), top.getArrayIndex());
 		if (params.isStackDebug()) {
 			tstr(string(("  ") + stack.toString()).c_str());
 		}
-		emitKey(stack);
+		emitKey(stack.depth(), inArray, top.getKey());
+	}
+
+	/**
+	 * Emit a comma and/or object label for a tape entry, as nextLine(const BSONParserStack&) does for its event.
+	 */
+	void nextLine(const BSONEventTape& tape, size_t i) {
+		const BSONEventTape::Entry& e = tape.entry(i);
+		emitComma(e.depth, e.inArray, e.elementIndex, e.arrayIndex);
+		emitKey(e.depth, e.inArray, e.inArray ? StringData() : tape.key(i));
+	}
+
+	void endObject(int depth) {
+		istr("}", depth); // End the JSON object.
+		if (lineDelimited && depth == 1) {
+			tstr("\n"); // End the document's line.
+		}
+	}
+
+	void writeValue(const BSONElement& element) {
+		if (extendedWriter) {
+			extendedWriter->write(*out, element); // Output element value as Extended JSON v2.
+		} else {
+			valueWriter.write(*out, element); // Output element value as JSON, untruncated, in bounded pieces.
+		}
+		if (params.isDebug()) out->flush(); // "Token Buffering" on debug.
+	}
+
+	/**
+	 * Emit the summary of an elision: a string value in place of an object or array, or a string element following the array's last element.
+	 */
+	void writeElision(const BSONElision& elision, int depth) {
+		string s("\"");
+		s += elision.summary(); // The summary contains no quotes or backslashes.
+		s += "\"";
+		if (elision.kind == BSONElision::DEPTH) {
+			tstr(s);
+		} else {
+			if (elision.index > 0) {
+				tstr(",");
+			}
+			istr(s, depth + 1);
+		}
 	}
 
 protected: // IBSONObjectVisitor overrides. ---------------------------------------------------------------------------
@@ -137,7 +178,7 @@ protected: // IBSONObjectVisitor overrides. ------------------------------------
 	}
 
 	virtual void onObjectEnd(const BSONParserStack& stack) {
-		istr("}", stack.depth()); // End the JSON object.
+		endObject(stack.depth());
 	}
 
 	virtual void onArrayStart(const BSONParserStack& stack) {
@@ -151,9 +192,29 @@ protected: // IBSONObjectVisitor overrides. ------------------------------------
 
 	virtual void onElement(const BSONParserStack& stack) {
 		nextLine(stack);
-		// TODO: Some element values produced by element.toString(..) need quoting for JSON.
-		string s(stack.top().getElement().toString(false,false));
-		tstr(s); // Output element value.
+		writeValue(stack.top().getElement());
+	}
+
+	virtual void onElided(const BSONParserStack& stack, const BSONElision& elision) {
+		if (elision.kind == BSONElision::DEPTH) {
+			nextLine(stack);
+		}
+		writeElision(elision, stack.depth());
+	}
+
+	virtual bool isArrayCountRequired() const {
+		return false; // The array count is never output.
+	}
+
+	virtual IBSONObjectVisitor* fork(OutputSink& fragment) {
+		JSONDump* forked = new JSONDump(params, indent.getIndentStr().c_str(),
+				extendedWriter ? new ExtendedJSONWriter(extendedWriter->getMode()) : NULL, lineDelimited);
+		forked->setOutputSink(fragment);
+		return forked;
+	}
+
+	virtual void join(const OutputSink& fragment) {
+		*out << fragment;
 	}
 
 public: // User Interface ---------------------------------------------------------------------------------------------
@@ -162,31 +223,40 @@ public: // User Interface ------------------------------------------------------
 	 * \brief Construct a BSON object dumper.
 	 * \param[in] pparams The command line parameters object.
 	 * \param[in] pindentStr The string used to indent the text output. The indent text is prepended to the output lines once for each indent level.
+	 * \param[in] pextendedWriter The Extended JSON v2 writer of the element values, owned by the dumper, or NULL for the JSON values
+	 * of BSONValueWriter.
+	 * \param[in] plineDelimited True to write each document on one line of its own, without the top-level array, commas
+	 * between documents, or indentation.
 	 */
-	JSONDump(Parameters& pparams, const char *pindentStr = " ") :
-		params(pparams), indentStr(pindentStr) {}
+	JSONDump(Parameters& pparams, const char *pindentStr = " ", ExtendedJSONWriter* pextendedWriter = NULL, bool plineDelimited = false) :
+		params(pparams), indent(pindentStr), valueWriter(pparams.getBufferSize()), extendedWriter(pextendedWriter),
+		lineDelimited(plineDelimited), objectParser(*this, pparams), out(NULL) {}
 
 	virtual ~JSONDump() {};
 
 	/*
-	 * \param[in] os The output stream to which the object(s) are rendered.
+	 * \param[in] sink The output sink to which the object(s) are rendered.
 	 */
-	virtual void setOutputStream(std::ostream& os) {
-		getOStream = [&] () -> ostream& { return os; }; // Wrap closure around ostream.
+	virtual void setOutputSink(OutputSink& sink) {
+		out = &sink;
 	}
 
 	/*
 	 * \param[in] prefix The string to be output before the object is rendered, or NULL.
 	 */
 	virtual void begin(const char* prefix) {
-		tstr("[");
+		if (!lineDelimited) {
+			tstr("[");
+		}
 	}
 
 	/*
 	 * \param[in] suffix The string to be output after the object is rendered, or NULL.
 	 */
 	virtual void end(const char* suffix) {
-		tstr("\n]");
+		if (!lineDelimited) {
+			tstr("\n]");
+		}
 	}
 
 	/*
@@ -194,11 +264,62 @@ public: // User Interface ------------------------------------------------------
 	 * \param[in] pobject The output stream.
 	 */
 	virtual void render(const BSONObj& object, int docIndex, int docCount) {
-		if (docIndex > 0) {
+		beginDocument(docIndex, docCount);
+		objectParser.parse(object);     // !!! MAJOR ACTION HERE !!! >>> Parse the object and write to the output stream.
+	}
+
+	virtual void renderTape(const BSONEventTape& tape, int docIndex, int docCount) {
+		beginDocument(docIndex, docCount);
+		for (size_t i = 0; i < tape.size(); i++) {
+			const BSONEventTape::Entry& e = tape.entry(i);
+			switch (e.event) {
+			case BSONParseCursor::OBJECT_START:
+				nextLine(tape, i);
+				tstr("{");
+				break;
+			case BSONParseCursor::OBJECT_END:
+				endObject(e.depth);
+				break;
+			case BSONParseCursor::ARRAY_START:
+				nextLine(tape, i);
+				tstr("[");
+				break;
+			case BSONParseCursor::ARRAY_END:
+				istr("]", e.depth);
+				break;
+			case BSONParseCursor::ELEMENT:
+				nextLine(tape, i);
+				writeValue(tape.element(i));
+				break;
+			case BSONParseCursor::ELIDED:
+				if (tape.elision(i).kind == BSONElision::DEPTH) {
+					nextLine(tape, i);
+				}
+				writeElision(tape.elision(i), e.depth);
+				break;
+			default:
+				throw std::logic_error("ISE: Undefined tape event!");
+			}
+		}
+	}
+
+	virtual void renderBatch(const BSONObj* objects, int count, int firstIndex, int docCount) {
+		renderEach(*this, objects, count, firstIndex, docCount);
+		flush();
+	}
+
+	virtual void flush() {
+		out->flush();
+	}
+
+	virtual void beginDocument(int docIndex, int docCount) {
+		if (docIndex > 0 && !lineDelimited) {
 			tstr(",");
 		}
-		BSONObjectParser objectParser(*this); // Construct a parser around this event handler.
-		objectParser.parse(object);     // !!! MAJOR ACTION HERE !!! >>> Parse the object and write to the output stream.
+	}
+
+	virtual IBSONObjectVisitor& getVisitor() {
+		return *this;
 	}
 };
 
@@ -0,0 +1,96 @@
+/*!
+ * \file JSONStringEncoder.hpp
+ * \brief JSON String Escaping Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef JSONSTRINGENCODER_HPP_
+#define JSONSTRINGENCODER_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <mongotype.hpp>
+#include <OutputSink.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class JSONStringEncoder
+ * \brief Writes text as JSON string literals per RFC 8259.
+ *
+ * The quotation mark, the reverse solidus and the control characters U+0000 to U+001F are escaped, using the two
+ * character escapes where JSON has one and \\u00XX otherwise. All other bytes, including UTF-8 sequences, are
+ * copied unchanged. The text is scanned 32 (AVX2) or 16 (SSE2) bytes at a time for the bytes to escape, and each
+ * run of bytes between them is copied to the output sink in one write.
+ */
+
+class JSONStringEncoder {
+public:
+	/*!
+	 * \return The length of the longest prefix of the bytes that needs no escaping.
+	 */
+	static size_t cleanPrefix(const unsigned char* p, size_t n);
+
+	/*!
+	 * \brief Write the bytes escaped, without the enclosing quotation marks.
+	 * \param[in] sink The output sink.
+	 * \param[in] p The bytes.
+	 * \param[in] n The count of bytes.
+	 */
+	static void writeEscaped(OutputSink& sink, const char* p, size_t n);
+
+	/*!
+	 * \brief Write the bytes as a JSON string literal, i.e., escaped and enclosed in quotation marks.
+	 * \param[in] sink The output sink.
+	 * \param[in] p The bytes.
+	 * \param[in] n The count of bytes.
+	 */
+	static void writeQuoted(OutputSink& sink, const char* p, size_t n) {
+		sink << '"';
+		writeEscaped(sink, p, n);
+		sink << '"';
+	}
+
+	static void writeQuoted(OutputSink& sink, const StringData& s) {
+		writeQuoted(sink, s.rawData(), s.size());
+	}
+
+	static void writeQuoted(OutputSink& sink, const string& s) {
+		writeQuoted(sink, s.data(), s.size());
+	}
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* JSONSTRINGENCODER_HPP_ */
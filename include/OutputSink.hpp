@@ -0,0 +1,184 @@
+/*!
+ * \file OutputSink.hpp
+ * \brief Buffered Renderer Output Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef OUTPUTSINK_HPP_
+#define OUTPUTSINK_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <cstring>
+
+#include <mongotype.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class OutputSink
+ * \brief The byte sink every renderer writes its output to.
+ *
+ * Renderers append text tokens directly into one large reusable buffer, a non-virtual inline copy per token, and the
+ * buffer is written to a file descriptor with write(2) when it fills or is flushed. A token too large for the buffer
+ * is written together with the buffered bytes by a single writev(2), without being copied. This bypasses the
+ * std::ostream sentry, locale and stdio synchronization costs paid by std::cout on every token.
+ *
+ * A sink constructed without a file descriptor is a memory sink: its buffer grows to hold everything written, and
+ * the caller retrieves the bytes with data() and size(), e.g., the fragments of an array split between threads.
+ */
+
+class OutputSink {
+	int fd;			/*!< The file descriptor, -1 for a memory sink. */
+	bool ownsFd;	/*!< True to close the file descriptor on destruction. */
+	vector<char> buffer;
+	size_t used;
+
+	void overflow(const char* p, size_t n);
+
+	OutputSink(const OutputSink&);
+	OutputSink& operator=(const OutputSink&);
+
+public:
+	/*!
+	 * \brief Construct a sink writing to a file descriptor.
+	 * \param[in] pfd The file descriptor, e.g., STDOUT_FILENO or a file opened for --output.
+	 * \param[in] powned True to close the file descriptor when the sink is destroyed.
+	 * \param[in] bufferSize The buffer size, i.e., --bufsize.
+	 */
+	OutputSink(int pfd, bool powned, size_t bufferSize);
+
+	/*!
+	 * \brief Construct a memory sink.
+	 */
+	OutputSink();
+
+	/*!
+	 * Flushes the sink, ignoring errors, and closes an owned file descriptor.
+	 */
+	virtual ~OutputSink();
+
+	/*!
+	 * \brief Append bytes.
+	 * \param[in] p The bytes.
+	 * \param[in] n The count of bytes.
+	 * \throws std::runtime_error If the bytes must be written and the write fails.
+	 */
+	void write(const char* p, size_t n) {
+		if (n <= buffer.size() - used) {
+			memcpy(buffer.data() + used, p, n);
+			used += n;
+		} else {
+			overflow(p, n);
+		}
+	}
+
+	OutputSink& operator<<(char c) {
+		if (used == buffer.size()) {
+			overflow(&c, 1);
+		} else {
+			buffer[used++] = c;
+		}
+		return *this;
+	}
+
+	OutputSink& operator<<(const char* s) {
+		write(s, strlen(s));
+		return *this;
+	}
+
+	OutputSink& operator<<(const string& s) {
+		write(s.data(), s.size());
+		return *this;
+	}
+
+	OutputSink& operator<<(const StringData& s) {
+		write(s.rawData(), s.size());
+		return *this;
+	}
+
+	/*!
+	 * \brief Append an integer in decimal.
+	 */
+	OutputSink& operator<<(long long value);
+
+	OutputSink& operator<<(int value) {
+		return *this << (long long) value;
+	}
+
+	/*!
+	 * \brief Append the bytes held by a memory sink.
+	 */
+	OutputSink& operator<<(const OutputSink& fragment) {
+		write(fragment.data(), fragment.size());
+		return *this;
+	}
+
+	/*!
+	 * \brief Write the buffered bytes to the file descriptor. Does nothing for a memory sink.
+	 * \throws std::runtime_error If the write fails.
+	 */
+	void flush();
+
+	/*!
+	 * \return The bytes of a memory sink, or the bytes not yet flushed.
+	 */
+	const char* data() const {
+		return buffer.data();
+	}
+
+	/*!
+	 * \return The count of bytes returned by data().
+	 */
+	size_t size() const {
+		return used;
+	}
+
+	/*!
+	 * \brief Discard the bytes returned by data(), retaining the buffer.
+	 */
+	void clear() {
+		used = 0;
+	}
+
+	/*!
+	 * \brief Discard the bytes returned by data(), and release the buffer of a memory sink grown beyond a capacity.
+	 * \param[in] capacity The largest buffer retained, e.g., --bufsize.
+	 */
+	void trim(size_t capacity);
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* OUTPUTSINK_HPP_ */
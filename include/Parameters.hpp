@@ -33,10 +33,14 @@
 #define PARAMETERS_HPP_
 
 #include <mongotype.hpp>
+#include <BSONPathFilter.hpp>
 
 #define DEFAULT_CONFIGURATION_FILE "~/.mongotype"
 #define DEFAULT_HOST "localhost"
 #define DEFAULT_PORT 27017
+#define DEFAULT_BUFFER_SIZE 65536
+#define DEFAULT_SPLIT_ELEMS 10000
+#define DEFAULT_SAMPLE_SIZE 1000
 
 namespace mongotype {
 
@@ -49,7 +53,22 @@ enum StyleParam {
 	STYLE_DOTTED     = 0,	/**< Dotted Output: see \ref BSONDotNotationDump */
 	STYLE_TREE       = 1,	/**< Tree Output: see \ref BSONObjectTypeDump  */
 	STYLE_JSON       = 2,	/**< Pretty JSON Output: see \ref JSONDump */
-	STYLE_JSONPACKED = 3	/**< Packed JSON Output: see \ref JSONDump */
+	STYLE_JSONPACKED = 3,	/**< Packed JSON Output: see \ref JSONDump */
+	STYLE_EJSON      = 4,	/**< Canonical Extended JSON v2 Output: see \ref ExtendedJSONWriter */
+	STYLE_EJSONRELAXED = 5,	/**< Relaxed Extended JSON v2 Output: see \ref ExtendedJSONWriter */
+	STYLE_NDJSON     = 6,	/**< Line Delimited JSON Output, one document per line: see \ref JSONDump */
+	STYLE_CSV        = 7,	/**< Comma Separated Flattened Table Output: see \ref BSONTableDump */
+	STYLE_TSV        = 8,	/**< Tab Separated Flattened Table Output: see \ref BSONTableDump */
+	STYLE_ARROW      = 9	/**< Apache Arrow IPC Stream Output: see \ref BSONArrowDump */
+};
+
+/**
+ * An --output option: an output style and the file it is written to.
+ */
+
+struct OutputParam {
+	StyleParam style;	/**< The output style. */
+	string path;		/**< The output file path, or "-" for standard output. */
 };
 
 enum TypeParamMask {
@@ -101,9 +120,23 @@ class Parameters {
     string host;
     int port;
     bool scalarFirst;
+    int maxDepth;
+    int maxArrayElems;
+    int bufferSize;
+    int threads;
+    int splitElems;
     StyleParam style;
     TypeParamMask typeMask;
     string dbCollection;
+    vector<string> includePaths;
+    vector<string> excludePaths;
+    vector<string> outputSpecs;
+    vector<OutputParam> outputs;
+    vector<string> columnSpecs;
+    vector<string> columns;
+    int sampleSize;
+    BSONPathFilter pathFilter;
+    string cacheDir;
 //    string query;
 //    string projection;
 
@@ -122,6 +155,8 @@ public:
 
 	bool isStackDebug() { return vm.count("stack") > 0; }
 
+	bool isTrusted() { return vm.count("trusted") > 0; }
+
 	const string& getConfigFile() const {
 		return config_file;
 	}
@@ -150,6 +185,41 @@ public:
 		return scalarFirst;
 	}
 
+	/**
+	 * \return The deepest nesting level of objects and arrays rendered per --max-depth, deeper ones are summarized. Zero for no limit.
+	 */
+	int getMaxDepth() const {
+		return maxDepth;
+	}
+
+	/**
+	 * \return The count of elements rendered per array per --max-array-elems, further elements are summarized. Zero for no limit.
+	 */
+	int getMaxArrayElems() const {
+		return maxArrayElems;
+	}
+
+	/**
+	 * \return The --bufsize size in bytes of the buffers through which large values are written.
+	 */
+	int getBufferSize() const {
+		return bufferSize;
+	}
+
+	/**
+	 * \return The --threads count of threads rendering concurrently, 1 for none.
+	 */
+	int getThreads() const {
+		return threads;
+	}
+
+	/**
+	 * \return The --split-elems count of elements from which an array is split between the --threads.
+	 */
+	int getSplitElems() const {
+		return splitElems;
+	}
+
 	StyleParam getStyle() const {
 		return style;
 	}
@@ -158,6 +228,42 @@ public:
 		return typeMask;
 	}
 
+	/**
+	 * \return The --output styles and files, or an empty vector to output only --style to standard output.
+	 */
+	const vector<OutputParam>& getOutputs() const {
+		return outputs;
+	}
+
+	/**
+	 * \return The --columns dotted paths of the csv and tsv styles, or an empty vector to sample them.
+	 */
+	const vector<string>& getColumns() const {
+		return columns;
+	}
+
+	/**
+	 * \return The --sample count of documents whose dotted paths are the csv and tsv columns when there are no --columns,
+	 * and whose types are the arrow schema.
+	 */
+	int getSampleSize() const {
+		return sampleSize;
+	}
+
+	/**
+	 * \return The --cache directory holding local copies of scanned collections, or an empty string if caching is disabled.
+	 */
+	const string& getCacheDir() const {
+		return cacheDir;
+	}
+
+	/**
+	 * \return The filter compiled from the --include and --exclude path patterns.
+	 */
+	const BSONPathFilter& getPathFilter() const {
+		return pathFilter;
+	}
+
 	friend ostream& operator <<(ostream& os, Parameters& p);
 };
 
@@ -0,0 +1,116 @@
+/*!
+ * \file WorkerPool.hpp
+ * \brief Persistent Worker Thread Pool Definitions
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#ifndef WORKERPOOL_HPP_
+#define WORKERPOOL_HPP_
+
+//----------------------------------------------------------------------------
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include <mongotype.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \class WorkerPool
+ * \brief Persistent threads sharing the tasks of jobs submitted by other threads.
+ *
+ * The threads are started once and wait idle between jobs, so a job costs a wake up rather than a thread start and
+ * join. A job's tasks are claimed one at a time by the submitting thread and by any idle pool threads, so a job
+ * always progresses even when every pool thread is busy with the jobs of other threads.
+ */
+
+class WorkerPool {
+	/*!
+	 * \brief The tasks of one call to run(), guarded by the pool mutex.
+	 */
+	struct Job {
+		const function<void(int)>& task;
+		int count;
+		int next;		/*!< The next task to claim. */
+		int active;		/*!< The count of pool threads running the job's tasks. */
+		std::exception_ptr error;
+
+		Job(const function<void(int)>& ptask, int pcount) : task(ptask), count(pcount), next(0), active(0) {}
+	};
+
+	vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable jobReady;	/*!< Signalled when a job is queued, or on stop. */
+	std::condition_variable jobIdle;	/*!< Signalled when a pool thread leaves a job. */
+	deque<Job*> jobs;					/*!< The jobs with unclaimed tasks, oldest first. */
+	bool stopping;
+
+	void work();
+	void runTasks(Job& job, std::unique_lock<std::mutex>& lock);
+	void stop();
+
+public:
+	/*!
+	 * \param[in] threadCount The count of pool threads, the threads submitting jobs are additional.
+	 * \throws std::system_error If a thread cannot be started, once the threads already started are joined.
+	 */
+	WorkerPool(int threadCount);
+
+	/*!
+	 * Stops and joins the pool threads.
+	 */
+	virtual ~WorkerPool();
+
+	/*!
+	 * \brief The pool shared by every BSONObjectParser splitting arrays, started by the first call and stopped at exit.
+	 * \param[in] threadCount The count of pool threads, used by the first call only.
+	 * \return The pool.
+	 */
+	static WorkerPool& shared(int threadCount);
+
+	/*!
+	 * \brief Run tasks 0 to count-1, each exactly once, on the calling thread and any idle pool threads.
+	 * \param[in] count The count of tasks.
+	 * \param[in] task The task body, called with the task index.
+	 * \throws The first exception thrown by a task, once no thread is running the job's tasks. The unclaimed tasks are abandoned.
+	 */
+	void run(int count, const function<void(int)>& task);
+};
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
+
+//----------------------------------------------------------------------------
+
+#endif /* WORKERPOOL_HPP_ */
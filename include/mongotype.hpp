@@ -37,6 +37,7 @@
 #include <iterator>
 #include <cstdlib>
 #include <functional>
+#include <algorithm>
 
 #include <boost/any.hpp>
 #include <boost/program_options.hpp>
@@ -0,0 +1,358 @@
+/*!
+ * \file ArrowIPCWriter.cpp
+ * \brief Apache Arrow IPC Stream Output Implementation
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#include <cstring>
+#include <algorithm>
+
+#include "ArrowIPCWriter.hpp"
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * The flatbuffer MetadataVersion of the format, V5.
+ */
+static const int16_t METADATA_VERSION = 4;
+
+/*!
+ * The flatbuffer MessageHeader union types.
+ */
+static const uint8_t HEADER_SCHEMA = 1;
+static const uint8_t HEADER_RECORD_BATCH = 3;
+
+/*!
+ * The marker preceding each message's metadata length.
+ */
+static const uint32_t CONTINUATION = 0xFFFFFFFF;
+
+/*!
+ * The alignment of messages and body buffers.
+ */
+static const size_t ALIGNMENT = 8;
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \brief A flatbuffer built front to back.
+ *
+ * The root offset comes first, and every table, vector and string is written after the offset field referencing it,
+ * so each unsigned offset points forward as the format requires, and is set by link() once its target is written.
+ * A table's vtable is written just before it, the vtable offset being positive.
+ */
+
+class FlatBuffer {
+	string buf;
+
+public:
+	/*!
+	 * \brief A table under construction: its scalar and offset fields, written by FlatBuffer::writeTable().
+	 */
+	class Table {
+		friend class FlatBuffer;
+		struct Slot {
+			int id;
+			size_t size;
+			uint64_t value;
+		};
+		vector<Slot> slots;
+	public:
+		template <class T> void add(int id, T value) {
+			uint64_t v = 0;
+			memcpy(&v, &value, sizeof(value));
+			slots.push_back(Slot{ id, sizeof(value), v });
+		}
+		/*!
+		 * \brief Reserve an offset field, set by FlatBuffer::link() once its target is written.
+		 */
+		void addOffset(int id) {
+			add<uint32_t>(id, 0);
+		}
+	};
+
+	FlatBuffer() {
+		put<uint32_t>(0); // The root table offset.
+	}
+
+	const string& data() const {
+		return buf;
+	}
+
+	void pad(size_t alignment) {
+		while (buf.size() % alignment != 0) {
+			buf += '\0';
+		}
+	}
+
+	template <class T> size_t put(T value) {
+		pad(sizeof(value));
+		size_t position = buf.size();
+		buf.append(reinterpret_cast<const char*>(&value), sizeof(value));
+		return position;
+	}
+
+	/*!
+	 * \brief Set an offset to an object written after it.
+	 * \param[in] position The position of the offset field or vector element.
+	 * \param[in] target The position of the table, or the length of the vector or string.
+	 */
+	void link(size_t position, size_t target) {
+		uint32_t offset = target - position;
+		memcpy(&buf[position], &offset, sizeof(offset));
+	}
+
+	/*!
+	 * \brief Write a table preceded by its vtable.
+	 * \param[in] table The table's fields.
+	 * \param[out] positions The position of each field by id, e.g., to link() offset fields.
+	 * \return The table's position.
+	 */
+	size_t writeTable(Table& table, vector<size_t>& positions) {
+		std::stable_sort(table.slots.begin(), table.slots.end(),
+				[] (const Table::Slot& a, const Table::Slot& b) { return a.size > b.size; }); // Largest first, aligned.
+		int fieldCount = 0;
+		size_t alignment = 4;
+		size_t end = 4; // After the vtable offset.
+		vector<size_t> fieldOffsets;
+		for (const Table::Slot& s : table.slots) {
+			fieldCount = std::max(fieldCount, s.id + 1);
+			alignment = std::max(alignment, s.size);
+			end = (end + s.size - 1) / s.size * s.size;
+			fieldOffsets.push_back(end);
+			end += s.size;
+		}
+		pad(2);
+		size_t vtable = buf.size();
+		buf.append(4 + 2 * fieldCount, '\0');
+		uint16_t header[2] = { (uint16_t)(4 + 2 * fieldCount), (uint16_t)end };
+		memcpy(&buf[vtable], header, sizeof(header));
+		pad(alignment);
+		size_t start = buf.size();
+		buf.append(end, '\0');
+		int32_t vtableOffset = start - vtable;
+		memcpy(&buf[start], &vtableOffset, sizeof(vtableOffset));
+		positions.assign(fieldCount, 0);
+		for (size_t i = 0; i < table.slots.size(); i++) {
+			const Table::Slot& s = table.slots[i];
+			uint16_t fieldOffset = fieldOffsets[i];
+			memcpy(&buf[vtable + 4 + 2 * s.id], &fieldOffset, sizeof(fieldOffset));
+			memcpy(&buf[start + fieldOffsets[i]], &s.value, s.size);
+			positions[s.id] = start + fieldOffsets[i];
+		}
+		return start;
+	}
+
+	/*!
+	 * \brief Write a vector's length, aligning its elements.
+	 * \param[in] count The count of elements.
+	 * \param[in] alignment The alignment of the elements.
+	 * \return The position of the length, the vector's position.
+	 */
+	size_t writeVectorLength(uint32_t count, size_t alignment) {
+		pad(4);
+		while ((buf.size() + 4) % alignment != 0) {
+			buf += '\0';
+		}
+		return put<uint32_t>(count);
+	}
+
+	/*!
+	 * \brief Write a vector of offsets, each set by link() once its target is written, the first following the length.
+	 * \return The vector's position.
+	 */
+	size_t writeOffsetVector(uint32_t count) {
+		size_t position = writeVectorLength(count, 4);
+		buf.append(4 * count, '\0');
+		return position;
+	}
+
+	/*!
+	 * \brief Write a vector of structs of two 64 bit integers, i.e., FieldNode or Buffer.
+	 */
+	size_t writeLongPairVector(const vector<pair<int64_t, int64_t>>& pairs) {
+		size_t position = writeVectorLength(pairs.size(), 8);
+		for (const pair<int64_t, int64_t>& p : pairs) {
+			put<int64_t>(p.first);
+			put<int64_t>(p.second);
+		}
+		return position;
+	}
+
+	size_t writeString(const string& s) {
+		size_t position = put<uint32_t>(s.size());
+		buf.append(s.data(), s.size());
+		buf += '\0';
+		return position;
+	}
+};
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \brief Write a Field table, its name, type and children.
+ * \return The Field table's position.
+ */
+
+static size_t writeField(FlatBuffer& fb, const ArrowIPCWriter::Field& field) {
+	FlatBuffer::Table table;
+	table.addOffset(0); // name
+	table.add<uint8_t>(1, 1); // nullable
+	table.add<uint8_t>(2, field.type); // type_type
+	table.addOffset(3); // type
+	table.addOffset(5); // children
+	vector<size_t> positions;
+	size_t position = fb.writeTable(table, positions);
+	fb.link(positions[0], fb.writeString(field.name));
+
+	FlatBuffer::Table type;
+	switch (field.type) {
+	case ArrowIPCWriter::INT:
+		type.add<int32_t>(0, field.width); // bitWidth
+		type.add<uint8_t>(1, field.isSigned); // is_signed
+		break;
+	case ArrowIPCWriter::FLOATING_POINT:
+		type.add<int16_t>(0, 2); // precision: DOUBLE
+		break;
+	case ArrowIPCWriter::TIMESTAMP:
+		type.add<int16_t>(0, 1); // unit: MILLISECOND
+		type.addOffset(1); // timezone
+		break;
+	case ArrowIPCWriter::FIXED_SIZE_BINARY:
+		type.add<int32_t>(0, field.width); // byteWidth
+		break;
+	default: // The Null, Binary, Utf8, Bool, List and Struct_ tables have no fields.
+		break;
+	}
+	vector<size_t> typePositions;
+	fb.link(positions[3], fb.writeTable(type, typePositions));
+	if (field.type == ArrowIPCWriter::TIMESTAMP) {
+		fb.link(typePositions[1], fb.writeString("UTC"));
+	}
+
+	size_t children = fb.writeOffsetVector(field.children.size());
+	fb.link(positions[5], children);
+	for (size_t i = 0; i < field.children.size(); i++) {
+		fb.link(children + 4 * (i + 1), writeField(fb, field.children[i]));
+	}
+	return position;
+}
+
+/*!
+ * \brief Start a Message flatbuffer.
+ * \return The position of the header offset field, to be linked to the header table written next.
+ */
+
+static size_t writeMessage(FlatBuffer& fb, uint8_t headerType, int64_t bodyLength) {
+	FlatBuffer::Table message;
+	message.add<int16_t>(0, METADATA_VERSION); // version
+	message.add<uint8_t>(1, headerType); // header_type
+	message.addOffset(2); // header
+	message.add<int64_t>(3, bodyLength); // bodyLength
+	vector<size_t> positions;
+	fb.link(0, fb.writeTable(message, positions));
+	return positions[2];
+}
+
+/*!
+ * \brief Write the encapsulated message's continuation marker, metadata length and metadata.
+ */
+
+static void writeMetadata(OutputSink& sink, const string& metadata) {
+	const char zeros[ALIGNMENT] = { 0 };
+	size_t padding = (ALIGNMENT - (8 + metadata.size()) % ALIGNMENT) % ALIGNMENT;
+	int32_t length = metadata.size() + padding;
+	sink.write(reinterpret_cast<const char*>(&CONTINUATION), sizeof(CONTINUATION));
+	sink.write(reinterpret_cast<const char*>(&length), sizeof(length));
+	sink.write(metadata.data(), metadata.size());
+	sink.write(zeros, padding);
+}
+
+static size_t padded(size_t size) {
+	return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+//----------------------------------------------------------------------------
+
+void ArrowIPCWriter::writeSchema(OutputSink& sink, const vector<Field>& fields) {
+	FlatBuffer fb;
+	size_t header = writeMessage(fb, HEADER_SCHEMA, 0);
+	FlatBuffer::Table schema;
+	schema.addOffset(1); // fields, the endianness defaulting to Little.
+	vector<size_t> positions;
+	fb.link(header, fb.writeTable(schema, positions));
+	size_t children = fb.writeOffsetVector(fields.size());
+	fb.link(positions[1], children);
+	for (size_t i = 0; i < fields.size(); i++) {
+		fb.link(children + 4 * (i + 1), writeField(fb, fields[i]));
+	}
+	writeMetadata(sink, fb.data());
+}
+
+void ArrowIPCWriter::writeRecordBatch(OutputSink& sink, int64_t length, const vector<FieldNode>& nodes, const vector<BodyBuffer>& buffers) {
+	vector<pair<int64_t, int64_t>> nodePairs;
+	for (const FieldNode& n : nodes) {
+		nodePairs.push_back(make_pair(n.length, n.nullCount));
+	}
+	vector<pair<int64_t, int64_t>> bufferPairs;
+	int64_t bodyLength = 0;
+	for (const BodyBuffer& b : buffers) {
+		bufferPairs.push_back(make_pair(bodyLength, (int64_t)b.size));
+		bodyLength += padded(b.size);
+	}
+
+	FlatBuffer fb;
+	size_t header = writeMessage(fb, HEADER_RECORD_BATCH, bodyLength);
+	FlatBuffer::Table batch;
+	batch.add<int64_t>(0, length); // length
+	batch.addOffset(1); // nodes
+	batch.addOffset(2); // buffers
+	vector<size_t> positions;
+	fb.link(header, fb.writeTable(batch, positions));
+	fb.link(positions[1], fb.writeLongPairVector(nodePairs));
+	fb.link(positions[2], fb.writeLongPairVector(bufferPairs));
+	writeMetadata(sink, fb.data());
+
+	const char zeros[ALIGNMENT] = { 0 };
+	for (const BodyBuffer& b : buffers) {
+		sink.write(b.data, b.size);
+		sink.write(zeros, padded(b.size) - b.size);
+	}
+}
+
+void ArrowIPCWriter::writeEndOfStream(OutputSink& sink) {
+	const int32_t length = 0;
+	sink.write(reinterpret_cast<const char*>(&CONTINUATION), sizeof(CONTINUATION));
+	sink.write(reinterpret_cast<const char*>(&length), sizeof(length));
+}
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
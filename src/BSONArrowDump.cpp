@@ -0,0 +1,504 @@
+/*!
+ * \file BSONArrowDump.cpp
+ * \brief BSON to Apache Arrow IPC Stream Dump Implementation
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#include <cstring>
+#include <stdint.h>
+
+#include "BSONArrowDump.hpp"
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+BSONArrowDump::Column* BSONArrowDump::Column::child(StringData key, bool create) {
+	string name(key.rawData(), key.size());
+	unordered_map<string, size_t>::const_iterator i = childIndex.find(name);
+	if (i != childIndex.end()) {
+		return children[i->second].get();
+	}
+	if (!create) {
+		return NULL;
+	}
+	childIndex[name] = children.size();
+	children.push_back(unique_ptr<Column>(new Column(name, NONE)));
+	return children.back().get();
+}
+
+void BSONArrowDump::Column::setKind(Kind pkind) {
+	if (pkind == kind) {
+		return;
+	}
+	kind = pkind;
+	if (kind != STRUCT) {
+		childIndex.clear();
+		children.clear();
+	}
+	if (kind == LIST) {
+		children.push_back(unique_ptr<Column>(new Column("item", NONE)));
+	}
+	reset();
+}
+
+void BSONArrowDump::Column::reset() {
+	length = 0;
+	nullCount = 0;
+	validity.clear();
+	values.clear();
+	offsets.clear();
+	data.clear();
+	if (kind == UTF8 || kind == BINARY || kind == LIST) {
+		appendOffset(0);
+	}
+	for (unique_ptr<Column>& c : children) {
+		c->reset();
+	}
+}
+
+void BSONArrowDump::Column::appendValidity(bool valid) {
+	int bit = length % 8;
+	if (bit == 0) {
+		validity += '\0';
+	}
+	if (valid) {
+		validity.back() |= (char) (1 << bit);
+	} else {
+		nullCount++;
+	}
+	length++;
+}
+
+void BSONArrowDump::Column::appendOffset(int32_t offset) {
+	offsets.append(reinterpret_cast<const char*>(&offset), sizeof(offset));
+}
+
+void BSONArrowDump::Column::appendNull() {
+	appendValidity(false);
+	switch (kind) {
+	case INT32:
+		values.append(4, '\0');
+		break;
+	case INT64:
+	case UINT64:
+	case DOUBLE:
+	case DATE:
+		values.append(8, '\0');
+		break;
+	case OBJECT_ID:
+		values.append(12, '\0');
+		break;
+	case BOOL:
+		if ((length - 1) % 8 == 0) {
+			values += '\0';
+		}
+		break;
+	case BINARY:
+	case UTF8:
+		appendOffset(data.size());
+		break;
+	case LIST:
+		appendOffset(children[0]->length);
+		break;
+	case STRUCT: // Every child has a value per struct value.
+		for (unique_ptr<Column>& c : children) {
+			c->appendNull();
+		}
+		break;
+	case NONE:
+		break;
+	}
+}
+
+void BSONArrowDump::Column::appendFixed(const void* p, size_t n) {
+	appendValidity(true);
+	values.append(static_cast<const char*>(p), n);
+}
+
+void BSONArrowDump::Column::appendBool(bool value) {
+	appendValidity(true);
+	int bit = (length - 1) % 8;
+	if (bit == 0) {
+		values += '\0';
+	}
+	if (value) {
+		values.back() |= (char) (1 << bit);
+	}
+}
+
+void BSONArrowDump::Column::appendBytes(const char* p, size_t n) {
+	appendValidity(true);
+	data.append(p, n);
+	appendOffset(data.size());
+}
+
+void BSONArrowDump::Column::fillChildren() {
+	for (unique_ptr<Column>& c : children) {
+		while (c->length < length) { // Missing from the object.
+			c->appendNull();
+		}
+	}
+}
+
+void BSONArrowDump::Column::endList() {
+	appendOffset(children[0]->length);
+}
+
+ArrowIPCWriter::Field BSONArrowDump::Column::toField() const {
+	static const ArrowIPCWriter::Type TYPES[] = {
+		ArrowIPCWriter::NULL_TYPE,			// NONE
+		ArrowIPCWriter::INT,				// INT32
+		ArrowIPCWriter::INT,				// INT64
+		ArrowIPCWriter::INT,				// UINT64
+		ArrowIPCWriter::FLOATING_POINT,		// DOUBLE
+		ArrowIPCWriter::BOOL,				// BOOL
+		ArrowIPCWriter::TIMESTAMP,			// DATE
+		ArrowIPCWriter::FIXED_SIZE_BINARY,	// OBJECT_ID
+		ArrowIPCWriter::BINARY,				// BINARY
+		ArrowIPCWriter::UTF8,				// UTF8
+		ArrowIPCWriter::LIST,				// LIST
+		ArrowIPCWriter::STRUCT				// STRUCT
+	};
+	ArrowIPCWriter::Field field(name, TYPES[kind], kind == INT32 ? 32 : kind == OBJECT_ID ? 12 : 64, kind != UINT64);
+	for (const unique_ptr<Column>& c : children) {
+		field.children.push_back(c->toField());
+	}
+	return field;
+}
+
+void BSONArrowDump::Column::collect(vector<ArrowIPCWriter::FieldNode>& nodes, vector<ArrowIPCWriter::BodyBuffer>& buffers) const {
+	nodes.push_back(ArrowIPCWriter::FieldNode{ length, nullCount });
+	if (kind == NONE) { // A null column has no buffers.
+		return;
+	}
+	// The validity bitmap may be omitted if there are no nulls.
+	buffers.push_back(ArrowIPCWriter::BodyBuffer{ validity.data(), nullCount > 0 ? validity.size() : 0 });
+	switch (kind) {
+	case UTF8:
+	case BINARY:
+		buffers.push_back(ArrowIPCWriter::BodyBuffer{ offsets.data(), offsets.size() });
+		buffers.push_back(ArrowIPCWriter::BodyBuffer{ data.data(), data.size() });
+		break;
+	case LIST:
+		buffers.push_back(ArrowIPCWriter::BodyBuffer{ offsets.data(), offsets.size() });
+		break;
+	case STRUCT:
+		break;
+	default:
+		buffers.push_back(ArrowIPCWriter::BodyBuffer{ values.data(), values.size() });
+		break;
+	}
+	for (const unique_ptr<Column>& c : children) {
+		c->collect(nodes, buffers);
+	}
+}
+
+//----------------------------------------------------------------------------
+
+BSONArrowDump::BSONArrowDump(Parameters& pparams) :
+		params(pparams), objectParser(*this, pparams), out(NULL), root("", STRUCT), skipDepth(0), batchBytes(0), sampling(true),
+		textWriter(ExtendedJSONWriter::RELAXED) {
+}
+
+BSONArrowDump::Kind BSONArrowDump::kindOf(int type) {
+	switch (type) {
+	case BSONType::NumberInt:		return INT32;
+	case BSONType::NumberLong:		return INT64;
+	case BSONType::Timestamp:		return UINT64;
+	case BSONType::NumberDouble:	return DOUBLE;
+	case BSONType::Bool:			return BOOL;
+	case BSONType::Date:			return DATE;
+	case BSONType::jstOID:			return OBJECT_ID;
+	case BSONType::BinData:			return BINARY;
+	case BSONType::Object:			return STRUCT;
+	case BSONType::Array:			return LIST;
+	case BSONType::jstNULL:
+	case BSONType::Undefined:		return NONE;
+	default:						return UTF8; // Strings, and the text of any other type.
+	}
+}
+
+BSONArrowDump::Kind BSONArrowDump::merge(Kind a, Kind b) {
+	if (a == b || b == NONE) {
+		return a;
+	}
+	if (a == NONE) {
+		return b;
+	}
+	if ((a == INT32 && b == INT64) || (a == INT64 && b == INT32)) {
+		return INT64;
+	}
+	if ((a == INT32 || a == INT64 || a == DOUBLE) && (b == INT32 || b == INT64 || b == DOUBLE)) {
+		return DOUBLE;
+	}
+	return UTF8;
+}
+
+BSONArrowDump::Column* BSONArrowDump::target(const BSONParserStack& stack, Kind kind) {
+	Column* parent = open.back();
+	Column* column = parent->kind == LIST ? parent->children[0].get() : parent->child(stack.top().getKey(), sampling);
+	if (column != NULL && !sampling && parent->kind == STRUCT && column->length >= parent->length) {
+		return NULL; // A repeated key, whose first value is kept so every child has one value per struct value.
+	}
+	if ((kind == STRUCT || kind == LIST) && open.size() > MAX_NESTING) {
+		kind = UTF8;
+	}
+	if (sampling && column != NULL) {
+		column->setKind(merge(column->kind, kind));
+	}
+	return column;
+}
+
+void BSONArrowDump::startNested(const BSONParserStack& stack, Kind kind) {
+	if (skipDepth > 0) {
+		skipDepth++;
+		return;
+	}
+	Column* column = target(stack, kind);
+	if (column != NULL && column->kind == kind) {
+		if (!sampling) {
+			column->appendValidity(true); // The children or items are appended as they are parsed.
+		}
+		open.push_back(column);
+		return;
+	}
+	if (column != NULL && !sampling) {
+		if (column->kind == UTF8) {
+			if (kind == STRUCT) {
+				appendText(*column, stack.top().getObject(), false);
+			} else {
+				appendText(*column, stack.top().getArray().embeddedObject(), true);
+			}
+		} else {
+			column->appendNull();
+		}
+	}
+	skipDepth = 1; // Step over the events of the object or array.
+}
+
+void BSONArrowDump::endNested() {
+	if (skipDepth > 0) {
+		skipDepth--;
+		return;
+	}
+	Column* column = open.back();
+	open.pop_back();
+	if (!sampling) {
+		if (column->kind == STRUCT) {
+			column->fillChildren();
+		} else {
+			column->endList();
+		}
+	}
+}
+
+void BSONArrowDump::onObjectStart(const BSONParserStack& stack) {
+	if (stack.depth() > 1) {
+		startNested(stack, STRUCT);
+		return;
+	}
+	open.assign(1, &root);
+	skipDepth = 0;
+	if (sampling) {
+		samples.push_back(stack.top().getObject().getOwned()); // The batch is only valid until the next is fetched.
+	} else {
+		root.appendValidity(true); // A row.
+	}
+}
+
+void BSONArrowDump::onObjectEnd(const BSONParserStack& stack) {
+	if (stack.depth() > 1) {
+		endNested();
+		return;
+	}
+	open.clear();
+	if (!sampling) {
+		root.fillChildren();
+		if (root.length >= ROWS_PER_BATCH || batchBytes >= BYTES_PER_BATCH) {
+			writeBatch();
+		}
+	}
+}
+
+void BSONArrowDump::onElement(const BSONParserStack& stack) {
+	if (skipDepth > 0) {
+		return;
+	}
+	const BSONElement& element = stack.top().getElement();
+	Column* column = target(stack, kindOf(element.type()));
+	if (column != NULL && !sampling) {
+		appendValue(*column, element);
+	}
+}
+
+void BSONArrowDump::onElided(const BSONParserStack& stack, const BSONElision& elision) {
+	if (skipDepth > 0 || elision.kind != BSONElision::DEPTH) { // The array elements omitted have no items.
+		return;
+	}
+	Column* column = target(stack, NONE); // A summarized object or array is null, whatever its column's type.
+	if (column != NULL && !sampling) {
+		column->appendNull();
+	}
+}
+
+void BSONArrowDump::appendValue(Column& column, const BSONElement& element) {
+	const int type = element.type();
+	const char* v = element.value();
+	if (type == BSONType::jstNULL || type == BSONType::Undefined) {
+		column.appendNull();
+		return;
+	}
+	switch (column.kind) {
+	case INT32:
+		if (type == BSONType::NumberInt) {
+			column.appendFixed(v, 4);
+			return;
+		}
+		break;
+	case INT64:
+		if (type == BSONType::NumberLong) {
+			column.appendFixed(v, 8);
+			return;
+		} else if (type == BSONType::NumberInt) {
+			int32_t n;
+			memcpy(&n, v, sizeof(n));
+			int64_t wide = n;
+			column.appendFixed(&wide, sizeof(wide));
+			return;
+		}
+		break;
+	case UINT64: // The increment in the low 32 bits, the seconds in the high.
+	case DATE: // The milliseconds since the epoch.
+		if (type == (column.kind == UINT64 ? BSONType::Timestamp : BSONType::Date)) {
+			column.appendFixed(v, 8);
+			return;
+		}
+		break;
+	case DOUBLE:
+		if (type == BSONType::NumberDouble || type == BSONType::NumberInt || type == BSONType::NumberLong) {
+			double d = element.number();
+			column.appendFixed(&d, sizeof(d));
+			return;
+		}
+		break;
+	case BOOL:
+		if (type == BSONType::Bool) {
+			column.appendBool(*v != 0);
+			return;
+		}
+		break;
+	case OBJECT_ID:
+		if (type == BSONType::jstOID) {
+			column.appendFixed(v, 12);
+			return;
+		}
+		break;
+	case BINARY:
+		if (type == BSONType::BinData) {
+			int32_t length;
+			memcpy(&length, v, sizeof(length));
+			const char* bytes = v + 5;
+			if (v[4] == 2 && length >= 4) { // The old binary subtype repeats the length.
+				bytes += 4;
+				length -= 4;
+			}
+			column.appendBytes(bytes, length);
+			batchBytes += length;
+			return;
+		}
+		break;
+	case UTF8:
+		if (type == BSONType::String || type == BSONType::Symbol || type == BSONType::Code) {
+			int32_t length;
+			memcpy(&length, v, sizeof(length));
+			column.appendBytes(v + 4, length - 1);
+			batchBytes += length;
+		} else if (type == ExtendedJSONWriter::NUMBER_DECIMAL) {
+			char buf[ExtendedJSONWriter::DECIMAL128_BUFFER_SIZE];
+			size_t n = ExtendedJSONWriter::formatDecimal128(v, buf);
+			column.appendBytes(buf, n);
+			batchBytes += n;
+		} else {
+			text.clear();
+			textWriter.write(text, element);
+			column.appendBytes(text.data(), text.size());
+			batchBytes += text.size();
+		}
+		return;
+	default:
+		break;
+	}
+	column.appendNull(); // The value does not fit the column's type.
+}
+
+void BSONArrowDump::appendText(Column& column, const BSONObj& object, bool isArray) {
+	text.clear();
+	textWriter.writeObject(text, object, isArray);
+	column.appendBytes(text.data(), text.size());
+	batchBytes += text.size();
+}
+
+void BSONArrowDump::endSampling() {
+	sampling = false;
+	vector<ArrowIPCWriter::Field> fields;
+	for (const unique_ptr<Column>& c : root.children) {
+		fields.push_back(c->toField());
+	}
+	ArrowIPCWriter::writeSchema(*out, fields);
+	root.reset();
+	for (const BSONObj& object : samples) {
+		objectParser.parse(object); // Append the document's row.
+	}
+	vector<BSONObj>().swap(samples);
+}
+
+void BSONArrowDump::writeBatch() {
+	vector<ArrowIPCWriter::FieldNode> nodes;
+	vector<ArrowIPCWriter::BodyBuffer> buffers;
+	for (const unique_ptr<Column>& c : root.children) {
+		c->collect(nodes, buffers);
+	}
+	ArrowIPCWriter::writeRecordBatch(*out, root.length, nodes, buffers);
+	root.reset();
+	batchBytes = 0;
+}
+
+void BSONArrowDump::end(const char* suffix) {
+	if (sampling) { // Fewer documents than the --sample count.
+		endSampling();
+	}
+	if (root.length > 0) {
+		writeBatch();
+	}
+	ArrowIPCWriter::writeEndOfStream(*out);
+}
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
@@ -28,9 +28,95 @@
 //----------------------------------------------------------------------------
 
 #include "BSONObjectParser.hpp"
+#include "BSONTypeMap.hpp"
 
 namespace mongotype {
 
-//PLACEHOLDER FOR FUTURE EXPANSION
+string BSONElision::summary() const {
+	string s;
+	if (kind == DEPTH) {
+		s += type == BSONType::Array ? "[... " : "{... ";
+	} else {
+		s += "... ";
+	}
+	s += to_string(count);
+	s += kind == DEPTH ? " element" : " more element";
+	if (count != 1) {
+		s += "s";
+	}
+	BSONElement none;
+	BSONTypeMap map(none);
+	const char* separator = ": ";
+	for (int t = 0; t < (int)types.size(); t++) {
+		if (types.test(t)) {
+			s += separator;
+			s += map.lookup((BSONType)(signed char)t).getName();
+			separator = "|";
+		}
+	}
+	if (kind == DEPTH) {
+		s += type == BSONType::Array ? "]" : "}";
+	}
+	return s;
+}
+
+//----------------------------------------------------------------------------
+
+bool BSONObjectParser::parseArraySplit(const BSONObj& array, int elementIndex, int elementCount, int arrayCount, BSONElision& tail) {
+	const int MIN_ELEMENT_SIZE = 3; // Type byte, one digit key and its NUL.
+	const int RANGES_PER_THREAD = 8;
+	if (keyTable != NULL || array.objsize() < splitElems * MIN_ELEMENT_SIZE) {
+		return false;
+	}
+
+	// Collect the selected elements so that ranges may be addressed by array index.
+	vector<BSONElement>& elements = level(stack.depth()).elements;
+	elements.clear();
+	BSONObjIterator i(array);
+	while (i.more()) {
+		BSONElement e = i.next();
+		if (isSelected(e, pathMatch)) {
+			if (maxArrayElems > 0 && (int)elements.size() >= maxArrayElems) {
+				tail.add(e);
+			} else {
+				elements.push_back(e);
+			}
+		}
+	}
+	const int n = elements.size();
+	const int rangeCount = std::min(n, threads * RANGES_PER_THREAD);
+	vector<unique_ptr<OutputSink>> fragments;
+	vector<unique_ptr<IBSONObjectVisitor>> forks;
+	if (n >= splitElems) {
+		for (int r = 0; r < rangeCount; r++) {
+			fragments.push_back(unique_ptr<OutputSink>(new OutputSink()));
+			forks.push_back(unique_ptr<IBSONObjectVisitor>(visitor.fork(*fragments.back())));
+			if (!forks.back()) {
+				forks.clear();
+				break;
+			}
+		}
+	}
+	if (forks.empty()) { // Too small to split, or not forkable.
+		for (int ai = 0; ai < n; ai++) {
+			parseElementRecursive(elements[ai], elements[ai].fieldNameStringData(), elementIndex, elementCount, ai, arrayCount);
+		}
+		return true;
+	}
+
+	WorkerPool::shared(threads - 1).run(rangeCount, [&] (int r) {
+		BSONObjectParser range(*this, *forks[r]);
+		const int end = (long long)n * (r + 1) / rangeCount;
+		for (int ai = (long long)n * r / rangeCount; ai < end; ai++) {
+			range.parseElementRecursive(elements[ai], elements[ai].fieldNameStringData(), elementIndex, elementCount, ai, arrayCount);
+		}
+	});
+	for (int r = 0; r < rangeCount; r++) {
+		visitor.join(*fragments[r]);
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------
 
 } /* namespace mongotype */
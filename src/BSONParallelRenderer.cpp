@@ -0,0 +1,179 @@
+/*!
+ * \file BSONParallelRenderer.cpp
+ * \brief Ordered Parallel Document Rendering Implementation
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#include "BSONParallelRenderer.hpp"
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * The count of slots per worker thread, enough for a worker to move on while its previous documents await emission.
+ */
+static const int SLOTS_PER_WORKER = 4;
+
+//----------------------------------------------------------------------------
+
+BSONParallelRenderer::BSONParallelRenderer(Parameters& pparams, Factory factory) :
+		renderer(factory()), out(NULL), bufferSize(pparams.getBufferSize()), objects(NULL), count(0), firstIndex(0), docCount(0), taped(false), parsed(0), next(0), emitted(0), active(0), stopping(false) {
+	const int threads = pparams.getThreads();
+	for (int s = 0; s < threads * SLOTS_PER_WORKER; s++) {
+		slots.push_back(unique_ptr<Slot>(new Slot()));
+	}
+	for (int t = 0; t < threads; t++) {
+		renderers.push_back(unique_ptr<IBSONRenderer>(factory()));
+	}
+	// The renderers are all of one style, the tapes record no stack to debug.
+	if (dynamic_cast<IBSONTapeRenderer*>(renderer.get()) != NULL && !pparams.isStackDebug()) {
+		builder = unique_ptr<BSONEventTape::Builder>(new BSONEventTape::Builder(pparams, renderer->getVisitor().isArrayCountRequired()));
+	}
+	try {
+		for (int t = 0; t < threads; t++) {
+			workers.push_back(std::thread(&BSONParallelRenderer::work, this, std::ref(*renderers[t])));
+		}
+	} catch (...) { // A joinable std::thread must not be destroyed.
+		stop();
+		throw;
+	}
+}
+
+BSONParallelRenderer::~BSONParallelRenderer() {
+	stop();
+}
+
+void BSONParallelRenderer::stop() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	workReady.notify_all();
+	for (std::thread& t : workers) {
+		t.join();
+	}
+	workers.clear();
+}
+
+void BSONParallelRenderer::work(IBSONRenderer& worker) {
+	const int window = slots.size();
+	IBSONTapeRenderer* tapeWorker = dynamic_cast<IBSONTapeRenderer*>(&worker);
+	std::unique_lock<std::mutex> lock(mutex);
+	for (;;) {
+		workReady.wait(lock, [&] () { return stopping || (next < claimable() && !error); });
+		if (stopping) {
+			return;
+		}
+		const int i = next++;
+		const bool fromTape = taped;
+		Slot& slot = *slots[i % window];
+		active++;
+		lock.unlock();
+		try {
+			slot.sink.clear();
+			worker.setOutputSink(slot.sink);
+			if (fromTape) {
+				tapeWorker->renderTape(slot.tape, firstIndex + i, docCount);
+				slot.tape.trim(bufferSize); // The document may not outlive the batch.
+			} else {
+				worker.render(objects[i], firstIndex + i, docCount);
+			}
+			lock.lock();
+			slot.done = true;
+		} catch (...) {
+			lock.lock();
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+		active--;
+		slotDone.notify_all();
+	}
+}
+
+void BSONParallelRenderer::renderBatch(const BSONObj* pobjects, int pcount, int pfirstIndex, int pdocCount) {
+	const int window = slots.size();
+	std::unique_lock<std::mutex> lock(mutex);
+	objects = pobjects;
+	count = pcount;
+	firstIndex = pfirstIndex;
+	docCount = pdocCount;
+	taped = builder && count >= (int)workers.size();
+	parsed = 0;
+	next = 0;
+	emitted = 0;
+	workReady.notify_all();
+	try {
+		while (emitted < count) {
+			Slot& slot = *slots[emitted % window];
+			if (taped && !slot.done && parsed < count && parsed < emitted + window) {
+				// Parse the next document onto its free slot's tape while the next document to emit is rendered.
+				lock.unlock();
+				builder->build(objects[parsed], slots[parsed % window]->tape);
+				lock.lock();
+				parsed++;
+				workReady.notify_one();
+				continue;
+			}
+			slotDone.wait(lock, [&] () { return slot.done || error; });
+			if (error) {
+				std::exception_ptr e(error);
+				error = std::exception_ptr();
+				std::rethrow_exception(e);
+			}
+			lock.unlock();
+			*out << slot.sink; // Emit the document's output in order, the slot's worker has moved on.
+			slot.sink.trim(bufferSize);
+			lock.lock();
+			slot.done = false;
+			emitted++;
+			workReady.notify_all();
+		}
+	} catch (...) { // Claim no more documents, and let the workers finish theirs before the batch goes.
+		if (!lock.owns_lock()) {
+			lock.lock();
+		}
+		next = count;
+		slotDone.wait(lock, [&] () { return active == 0; });
+		error = std::exception_ptr();
+		for (unique_ptr<Slot>& s : slots) {
+			s->done = false;
+			s->tape.clear();
+		}
+		count = 0;
+		throw;
+	}
+	count = 0;
+	lock.unlock();
+	flush();
+}
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
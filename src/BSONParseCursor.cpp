@@ -0,0 +1,246 @@
+/*!
+ * \file BSONParseCursor.cpp
+ * \brief BSON Object Pull-Parser Implementation
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#include "BSONParseCursor.hpp"
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \return True if the element is to be parsed, per BSONObjectParser::isSelected().
+ */
+
+static inline bool isSelected(const BSONElement& element, BSONPathFilter::Match match) {
+	switch (match) {
+	case BSONPathFilter::INCLUDED:
+		return true;
+	case BSONPathFilter::PARTIAL:
+		return element.type() == BSONType::Object || element.type() == BSONType::Array;
+	default:
+		return false;
+	}
+}
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \brief Push an OBJECT frame, selecting and ordering its elements as BSONObjectParser::parseObjectRecursive() does, and push the object onto the stack.
+ */
+
+void BSONParseCursor::pushObject(const BSONObj& container, StringData key, int elementIndex, int elementCount, int arrayIndex, int arrayCount,
+		BSONPathFilter::Match match, bool keyed) {
+	frames.push_back(Frame(BSONParserStackItem::OBJECT, container, BSONElement(), key, elementIndex, elementCount, arrayIndex, match, keyed));
+	Frame& f = frames.back();
+	BSONObjectParser::sortElements(f.container, f.elements);
+	if (pathFilter != NULL) {
+		f.matches.resize(f.elements.size());
+		size_t n = 0;
+		for (size_t i = 0; i < f.elements.size(); i++) {
+			path.push_back(f.elements[i].fieldNameStringData());
+			BSONPathFilter::Match m = pathFilter->match(path);
+			path.pop_back();
+			if (isSelected(f.elements[i], m)) {
+				f.elements[n] = f.elements[i];
+				f.matches[n++] = m;
+			}
+		}
+		f.elements.resize(n);
+	}
+	f.childCount = f.elements.size();
+	if (scalarFirst) {
+		// Scalars fill the order from the front and containers from the back, the containers are then put back in key order.
+		f.order.resize(f.childCount);
+		int front = 0, back = f.childCount;
+		for (int i = 0; i < f.childCount; i++) {
+			BSONType t = f.elements[i].type();
+			if (t == BSONType::Object || t == BSONType::Array) {
+				f.order[--back] = i;
+			} else {
+				f.order[front++] = i;
+			}
+		}
+		std::reverse(f.order.begin() + back, f.order.end());
+	}
+	stack.push(f.container, f.key, elementIndex, elementCount, arrayIndex, arrayCount);
+}
+
+/*!
+ * \brief Pop the innermost frame, and its key from the path.
+ */
+
+void BSONParseCursor::popFrame() {
+	if (frames.back().keyed) {
+		path.pop_back();
+	}
+	frames.pop_back();
+}
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \brief Enter a BSON element, pushing it onto the stack and producing its start event.
+ * \param[in] parent The frame containing the element, whose \ref Frame::child holds the element.
+ * \param[in] elementIndex See BSONParserStackItem::elementIndex.
+ * \param[in] elementCount See BSONParserStackItem::elementCount.
+ * \param[in] arrayIndex See BSONParserStackItem::arrayIndex.
+ * \param[in] arrayCount See BSONParserStackItem::arrayCount.
+ * \param[in] match The path filter match of the element.
+ * \param[in] keyed True if the element's key is part of the path, i.e., the parent is an object and a path filter is set.
+ * \return The event produced.
+ */
+
+BSONParseCursor::Event BSONParseCursor::enter(Frame& parent, int elementIndex, int elementCount, int arrayIndex, int arrayCount, BSONPathFilter::Match match, bool keyed) {
+	const BSONElement& e = parent.child;
+	StringData key(e.fieldNameStringData());
+	BSONType btype = e.type();
+	if ((btype == BSONType::Object || btype == BSONType::Array) && maxDepth > 0 && stack.depth() >= maxDepth) {
+		elision = BSONElision(BSONElision::DEPTH, btype);
+		BSONObjIterator i(e.embeddedObject());
+		while (i.more()) {
+			elision.add(i.next());
+		}
+		stack.push(BSONParserStackItem::ELEMENT, e, key, elementIndex, elementCount, arrayIndex, arrayCount);
+		dropPending = true;
+		return ELIDED;
+	}
+	switch (btype) {
+	case BSONType::Object:
+		if (keyed) {
+			path.push_back(key);
+		}
+		pushObject(e.embeddedObject(), key, elementIndex, elementCount, arrayIndex, arrayCount, match, keyed);
+		return OBJECT_START;
+	case BSONType::Array:
+		{
+			if (keyed) {
+				path.push_back(key);
+			}
+			frames.push_back(Frame(BSONParserStackItem::ARRAY, e.embeddedObject(), e, key, elementIndex, elementCount, arrayIndex, match, keyed));
+			Frame& f = frames.back();
+			f.childCount = BSONParserStackItem::ARRAY_COUNT_UNKNOWN;
+			if (countArrays) {
+				if (match == BSONPathFilter::PARTIAL) {
+					f.childCount = 0;
+					BSONObjIterator i(f.container);
+					while (i.more()) {
+						f.childCount += isSelected(i.next(), match);
+					}
+				} else {
+					f.childCount = f.container.nFields();
+				}
+			}
+			stack.push(BSONParserStackItem::ARRAY, f.element, f.key, elementIndex, elementCount, arrayIndex, arrayCount);
+		}
+		return ARRAY_START;
+	default:
+		stack.push(BSONParserStackItem::ELEMENT, e, key, elementIndex, elementCount, arrayIndex, arrayCount);
+		dropPending = true;
+		return ELEMENT;
+	}
+}
+
+/*!
+ * \brief Advance to the next selected child of the innermost frame, or close the frame when its children are exhausted.
+ * \return The event produced.
+ *
+ * The selected array elements beyond --max-array-elems are summarized by one ELIDED event before the ARRAY_END.
+ */
+
+BSONParseCursor::Event BSONParseCursor::advance() {
+	Frame& f = frames.back();
+	if (f.type == BSONParserStackItem::OBJECT) {
+		if (f.childIndex < f.childCount) {
+			int ei = f.childIndex++;
+			int i = scalarFirst ? f.order[ei] : ei;
+			f.child = f.elements[i];
+			return enter(f, ei, f.childCount, f.arrayIndex, 0, pathFilter != NULL ? f.matches[i] : f.match, pathFilter != NULL);
+		}
+		dropPending = true;
+		return OBJECT_END;
+	}
+	while (f.nextElement.more()) {
+		if (maxArrayElems > 0 && f.childIndex >= maxArrayElems) {
+			elision = BSONElision(BSONElision::ARRAY_TAIL, BSONType::Array, maxArrayElems);
+			while (f.nextElement.more()) {
+				BSONElement e = f.nextElement.next();
+				if (isSelected(e, f.match)) {
+					elision.add(e);
+				}
+			}
+			if (elision.count > 0) {
+				return ELIDED;
+			}
+			break;
+		}
+		f.child = f.nextElement.next();
+		if (isSelected(f.child, f.match)) { // Array elements share the array's path.
+			int ai = f.childIndex++;
+			return enter(f, f.elementIndex, f.elementCount, ai, f.childCount, f.match, false);
+		}
+	}
+	dropPending = true;
+	return ARRAY_END;
+}
+
+//----------------------------------------------------------------------------
+
+BSONParseCursor::Event BSONParseCursor::next() {
+	if (dropPending) {
+		dropPending = false;
+		stack.drop();
+		if (current == OBJECT_END || current == ARRAY_END) {
+			popFrame();
+		}
+	}
+	switch (current) {
+	case INITIAL:
+		current = PARSE_START;
+		break;
+	case PARSE_START:
+		path.clear();
+		pushObject(object, StringData(), 0, 1, -1, 0, pathFilter == NULL ? BSONPathFilter::INCLUDED : pathFilter->match(path), false);
+		current = OBJECT_START;
+		break;
+	case PARSE_END:
+	case DONE:
+		current = DONE;
+		break;
+	default:
+		current = frames.empty() ? PARSE_END : advance();
+		break;
+	}
+	return current;
+}
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
@@ -0,0 +1,150 @@
+/*!
+ * \file BSONPathFilter.cpp
+ * \brief BSON Path Include/Exclude Filter Implementation
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#include "BSONPathFilter.hpp"
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+static const string WILDCARD("*");
+
+/*!
+ * Split comma separated dotted path patterns into their key segments.
+ * \param[in] patterns The comma separated patterns.
+ * \param[out] compiled The vector to which the compiled patterns are appended.
+ * \throws std::invalid_argument If a pattern contains an empty key segment.
+ */
+
+void BSONPathFilter::compile(const string& patterns, vector<Pattern>& compiled) {
+	size_t start = 0;
+	while (start <= patterns.length()) {
+		size_t end = patterns.find(',', start);
+		if (end == string::npos) {
+			end = patterns.length();
+		}
+		string pattern(patterns, start, end - start);
+		if (!pattern.empty()) {
+			Pattern p;
+			size_t s = 0;
+			while (true) {
+				size_t e = pattern.find('.', s);
+				string segment(pattern, s, e == string::npos ? string::npos : e - s);
+				if (segment.empty()) {
+					throw std::invalid_argument(string("Invalid path pattern: \"") + pattern + "\"");
+				}
+				p.push_back(segment);
+				if (e == string::npos) {
+					break;
+				}
+				s = e + 1;
+			}
+			compiled.push_back(p);
+		}
+		start = end + 1;
+	}
+}
+
+/*!
+ * \return True if every segment of the pattern matches the leading keys of the path, i.e., the path is the pattern or lies below it.
+ */
+
+bool BSONPathFilter::isPrefix(const Pattern& pattern, const vector<StringData>& path) {
+	if (pattern.size() > path.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < pattern.size(); i++) {
+		if (pattern[i] != WILDCARD && StringData(pattern[i]) != path[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*!
+ * \return True if the path matches the leading segments of the pattern and is shorter, i.e., the path lies above the pattern.
+ */
+
+bool BSONPathFilter::isAncestor(const vector<StringData>& path, const Pattern& pattern) {
+	if (path.size() >= pattern.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < path.size(); i++) {
+		if (pattern[i] != WILDCARD && StringData(pattern[i]) != path[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+BSONPathFilter::Match BSONPathFilter::match(const vector<StringData>& path) const {
+	for (const Pattern& p : excludes) {
+		if (isPrefix(p, path)) {
+			return EXCLUDED;
+		}
+	}
+	if (includes.empty()) {
+		return INCLUDED;
+	}
+	Match rv = EXCLUDED;
+	for (const Pattern& p : includes) {
+		if (isPrefix(p, path)) {
+			return INCLUDED;
+		}
+		if (isAncestor(path, p)) {
+			rv = PARTIAL;
+		}
+	}
+	return rv;
+}
+
+//----------------------------------------------------------------------------
+
+static void outputPatterns(std::ostream& out, const char* label, const vector<vector<string>>& patterns) {
+	out << label << ":";
+	for (size_t i = 0; i < patterns.size(); i++) {
+		out << (i ? "," : "");
+		for (size_t j = 0; j < patterns[i].size(); j++) {
+			out << (j ? "." : "") << patterns[i][j];
+		}
+	}
+	out << "\n";
+}
+
+std::ostream& operator<<(std::ostream& out, const BSONPathFilter& f) {
+	outputPatterns(out, "include", f.includes);
+	outputPatterns(out, "exclude", f.excludes);
+	return out;
+}
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
@@ -0,0 +1,190 @@
+/*!
+ * \file BSONScanCache.cpp
+ * \brief Local Collection Scan Cache Implementation
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdint.h>
+
+#include "BSONScanCache.hpp"
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+static const char MAGIC[] = "MONGOTYPECACHE01";
+static const size_t MAGIC_LENGTH = sizeof(MAGIC) - 1;
+
+/*!
+ * \return The FNV-1a hash of the string formatted as 16 hexadecimal digits.
+ */
+
+static string hashName(const string& s) {
+	uint64_t h = 14695981039346656037ULL;
+	for (unsigned char c : s) {
+		h = (h ^ c) * 1099511628211ULL;
+	}
+	char buf[17];
+	snprintf(buf, sizeof(buf), "%016llx", (unsigned long long) h);
+	return string(buf);
+}
+
+//----------------------------------------------------------------------------
+
+BSONScanCache::BSONScanCache(const string& dir, const string& pkey) :
+		key(pkey), fd(-1), map(MAP_FAILED), mapLength(0), nextDoc(NULL), endDoc(NULL) {
+	path = dir;
+	if (!path.empty() && path[path.length() - 1] != '/') {
+		path += '/';
+	}
+	path += hashName(key);
+	path += ".bsoncache";
+	tempPath = path + ".tmp";
+}
+
+BSONScanCache::~BSONScanCache() {
+	close();
+	if (out) { // Abandoned before commit().
+		out.reset();
+		remove(tempPath.c_str());
+	}
+}
+
+void BSONScanCache::close() {
+	if (map != MAP_FAILED) {
+		munmap(map, mapLength);
+		map = MAP_FAILED;
+	}
+	if (fd >= 0) {
+		::close(fd);
+		fd = -1;
+	}
+	nextDoc = endDoc = NULL;
+}
+
+//----------------------------------------------------------------------------
+
+bool BSONScanCache::open(long long count, const BSONElement& maxId) {
+	close();
+	fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		close();
+		return false;
+	}
+	mapLength = st.st_size;
+	map = mmap(NULL, mapLength, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (map == MAP_FAILED) {
+		close();
+		return false;
+	}
+	madvise(map, mapLength, MADV_SEQUENTIAL);
+	const char* p = static_cast<const char*>(map);
+	const char* end = p + mapLength;
+
+	// Compare the header against the scan identity and the collection's current state.
+	int32_t length;
+	int64_t cachedCount;
+	bool fresh = (size_t)(end - p) >= MAGIC_LENGTH + sizeof(length) && memcmp(p, MAGIC, MAGIC_LENGTH) == 0;
+	if (fresh) {
+		p += MAGIC_LENGTH;
+		memcpy(&length, p, sizeof(length));
+		p += sizeof(length);
+		fresh = length >= 0 && end - p >= length + (int)(sizeof(cachedCount) + sizeof(length)) && key.compare(0, string::npos, p, length) == 0;
+	}
+	if (fresh) {
+		p += length;
+		memcpy(&cachedCount, p, sizeof(cachedCount));
+		p += sizeof(cachedCount);
+		memcpy(&length, p, sizeof(length));
+		p += sizeof(length);
+		fresh = cachedCount == count && length == maxId.size() && end - p >= length && memcmp(p, maxId.rawdata(), length) == 0;
+	}
+	if (!fresh) {
+		close();
+		return false;
+	}
+	nextDoc = p + length;
+	endDoc = end;
+	return true;
+}
+
+BSONObj BSONScanCache::next() {
+	int32_t length;
+	if (endDoc - nextDoc >= (int)sizeof(length)) {
+		memcpy(&length, nextDoc, sizeof(length));
+	} else {
+		length = 0;
+	}
+	if (length < 5 || length > endDoc - nextDoc) {
+		throw std::runtime_error(string("Truncated cache file: ") + path);
+	}
+	BSONObj object(nextDoc);
+	nextDoc += length;
+	return object;
+}
+
+//----------------------------------------------------------------------------
+
+void BSONScanCache::create(long long count, const BSONElement& maxId) {
+	out.reset(new ofstream(tempPath.c_str(), ios::binary | ios::trunc));
+	if (!*out) {
+		out.reset();
+		throw std::runtime_error(string("Cannot create cache file: ") + tempPath);
+	}
+	int32_t length = key.length();
+	int64_t cachedCount = count;
+	out->write(MAGIC, MAGIC_LENGTH);
+	out->write(reinterpret_cast<const char*>(&length), sizeof(length));
+	out->write(key.data(), length);
+	out->write(reinterpret_cast<const char*>(&cachedCount), sizeof(cachedCount));
+	length = maxId.size();
+	out->write(reinterpret_cast<const char*>(&length), sizeof(length));
+	out->write(maxId.rawdata(), length);
+}
+
+void BSONScanCache::commit() {
+	out->close();
+	bool ok = !out->fail();
+	out.reset();
+	if (!ok || rename(tempPath.c_str(), path.c_str()) != 0) {
+		remove(tempPath.c_str());
+		throw std::runtime_error(string("Cannot write cache file: ") + path);
+	}
+}
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
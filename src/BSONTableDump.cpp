@@ -0,0 +1,264 @@
+/*!
+ * \file BSONTableDump.cpp
+ * \brief Flattened CSV and TSV Table Dump Implementation
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#include <cstring>
+#include <stdint.h>
+
+#include "BSONTableDump.hpp"
+#include "BSONValueWriter.hpp"
+#include "ExtendedJSONWriter.hpp"
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+BSONTableDump::BSONTableDump(Parameters& pparams, char pdelimiter) :
+		params(pparams), delimiter(pdelimiter), objectParser(*this, pparams), out(NULL), sampling(pparams.getColumns().empty()) {
+	for (const string& column : pparams.getColumns()) {
+		addColumn(column);
+	}
+}
+
+size_t BSONTableDump::addColumn(const string& column) {
+	unordered_map<string, size_t>::iterator i = columnIndex.find(column);
+	if (i != columnIndex.end()) {
+		return i->second;
+	}
+	columnIndex[column] = columns.size();
+	columns.push_back(column);
+	cellRanges.push_back(make_pair(0, 0));
+	return columns.size() - 1;
+}
+
+void BSONTableDump::setCell(size_t column, const char* p, size_t n) {
+	size_t start = cells.size();
+	writeField(cells, p, n);
+	cellRanges[column] = make_pair(start, cells.size());
+	filled.push_back(column);
+}
+
+void BSONTableDump::writeField(OutputSink& sink, const char* p, size_t n) {
+	if (delimiter == '\t') { // Backslash escapes, a TSV field never contains a tab or line break.
+		size_t clean = 0;
+		for (size_t i = 0; i < n; i++) {
+			char escape;
+			switch (p[i]) {
+			case '\t':	escape = 't'; break;
+			case '\n':	escape = 'n'; break;
+			case '\r':	escape = 'r'; break;
+			case '\\':	escape = '\\'; break;
+			default:	continue;
+			}
+			sink.write(p + clean, i - clean);
+			sink << '\\' << escape;
+			clean = i + 1;
+		}
+		sink.write(p + clean, n - clean);
+		return;
+	}
+	size_t i = 0;
+	while (i < n && p[i] != delimiter && p[i] != '"' && p[i] != '\n' && p[i] != '\r') {
+		++i;
+	}
+	if (i == n) {
+		sink.write(p, n);
+		return;
+	}
+	sink << '"'; // RFC 4180: quoted, with each quote doubled.
+	size_t clean = 0;
+	for (const char* q; (q = static_cast<const char*>(memchr(p + clean, '"', n - clean))) != NULL; ) {
+		size_t quote = q - p;
+		sink.write(p + clean, quote + 1 - clean);
+		sink << '"';
+		clean = quote + 1;
+	}
+	sink.write(p + clean, n - clean);
+	sink << '"';
+}
+
+void BSONTableDump::writeHeader() {
+	for (size_t c = 0; c < columns.size(); c++) {
+		if (c > 0) {
+			*out << delimiter;
+		}
+		writeField(*out, columns[c].data(), columns[c].size());
+	}
+	*out << '\n';
+}
+
+void BSONTableDump::writeCells() {
+	for (size_t c = 0; c < columns.size(); c++) {
+		if (c > 0) {
+			*out << delimiter;
+		}
+		const pair<size_t, size_t>& range = cellRanges[c];
+		out->write(cells.data() + range.first, range.second - range.first);
+	}
+	*out << '\n';
+	for (size_t c : filled) {
+		cellRanges[c] = make_pair(0, 0);
+	}
+	filled.clear();
+}
+
+void BSONTableDump::writeRow() {
+	writeCells();
+	cells.clear();
+}
+
+void BSONTableDump::holdRow() {
+	for (size_t c : filled) {
+		if (cellRanges[c].second > cellRanges[c].first) { // Once per column, a column repeated by array keys has its last cell.
+			SampleCell cell;
+			cell.column = c;
+			cell.range = cellRanges[c];
+			sampleCells.push_back(cell);
+			cellRanges[c] = make_pair(0, 0);
+		}
+	}
+	filled.clear();
+	sampleRows.push_back(sampleCells.size()); // The cells stay in cells until the rows are written.
+}
+
+void BSONTableDump::endSampling() {
+	sampling = false;
+	writeHeader();
+	size_t first = 0;
+	for (size_t end : sampleRows) {
+		for (size_t i = first; i < end; i++) {
+			cellRanges[sampleCells[i].column] = sampleCells[i].range;
+			filled.push_back(sampleCells[i].column);
+		}
+		writeCells();
+		first = end;
+	}
+	cells.trim(params.getBufferSize()); // The held cells may be many.
+	vector<SampleCell>().swap(sampleCells);
+	vector<size_t>().swap(sampleRows);
+}
+
+void BSONTableDump::onElement(const BSONParserStack& stack) {
+	pushKey(stack);
+	if (sampling) { // Every sampled path is a column.
+		setValueCell(addColumn(path.str()), stack.top().getElement());
+	} else {
+		unordered_map<string, size_t>::const_iterator i = columnIndex.find(path.str());
+		if (i != columnIndex.end()) {
+			setValueCell(i->second, stack.top().getElement());
+		}
+	}
+	path.pop();
+}
+
+void BSONTableDump::setValueCell(size_t column, const BSONElement& element) {
+	const char* v = element.value();
+	int32_t length;
+	switch ((int)element.type()) {
+	case BSONType::String:
+	case BSONType::Code:
+	case BSONType::Symbol: // The text, straight from the BSON bytes.
+		memcpy(&length, v, sizeof(length));
+		setCell(column, v + 4, length - 1);
+		break;
+	case BSONType::jstNULL:
+	case BSONType::Undefined: // An empty cell.
+		break;
+	case BSONType::NumberDouble:
+		value.clear();
+		BSONValueWriter::writeDouble(value, element.number());
+		setCell(column, value.data(), value.size());
+		break;
+	case BSONType::NumberInt:
+		{
+			int32_t n;
+			memcpy(&n, v, sizeof(n));
+			value.clear();
+			value << n;
+			setCell(column, value.data(), value.size());
+		}
+		break;
+	case BSONType::NumberLong:
+		{
+			int64_t n;
+			memcpy(&n, v, sizeof(n));
+			value.clear();
+			value << (long long)n;
+			setCell(column, value.data(), value.size());
+		}
+		break;
+	case BSONType::Date: // ISO-8601 in the years 1970 to 9999, else the milliseconds since the epoch.
+		{
+			int64_t millis;
+			memcpy(&millis, v, sizeof(millis));
+			if (millis >= 0 && millis <= ExtendedJSONWriter::MAX_ISO_DATE) {
+				char buf[ExtendedJSONWriter::DATE_BUFFER_SIZE];
+				setCell(column, buf, ExtendedJSONWriter::formatISODate(millis, buf));
+			} else {
+				value.clear();
+				value << (long long)millis;
+				setCell(column, value.data(), value.size());
+			}
+		}
+		break;
+	case ExtendedJSONWriter::NUMBER_DECIMAL:
+		{
+			char buf[ExtendedJSONWriter::DECIMAL128_BUFFER_SIZE];
+			setCell(column, buf, ExtendedJSONWriter::formatDecimal128(v, buf));
+		}
+		break;
+	case BSONType::Bool:
+		setCell(column, *v ? "true" : "false", *v ? 4 : 5);
+		break;
+	default:
+		{
+			string text(element.toString(false, true));
+			setCell(column, text.data(), text.size());
+		}
+		break;
+	}
+}
+
+void BSONTableDump::onElided(const BSONParserStack& stack, const BSONElision& elision) {
+	if (elision.kind != BSONElision::DEPTH) { // The omitted array elements have no cells.
+		return;
+	}
+	pushKey(stack); // The summarized object or array's cell.
+	unordered_map<string, size_t>::const_iterator i = columnIndex.find(path.str());
+	if (sampling || i != columnIndex.end()) {
+		string summary(elision.summary());
+		setCell(sampling ? addColumn(path.str()) : i->second, summary.data(), summary.size());
+	}
+	path.pop();
+}
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
@@ -0,0 +1,273 @@
+/*!
+ * \file BSONValidator.cpp
+ * \brief BSON Document Validator Implementation
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#include <stdint.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "BSONValidator.hpp"
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+static int32_t readInt32(const char* p) {
+	int32_t i;
+	memcpy(&i, p, sizeof(i));
+	return i;
+}
+
+size_t BSONValidator::asciiPrefix(const unsigned char* p, size_t n) {
+	size_t i = 0;
+#if defined(__AVX2__)
+	for (; i + 32 <= n; i += 32) {
+		int mask = _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)));
+		if (mask) {
+			return i + __builtin_ctz(mask);
+		}
+	}
+#endif
+#if defined(__SSE2__)
+	for (; i + 16 <= n; i += 16) {
+		int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+		if (mask) {
+			return i + __builtin_ctz(mask);
+		}
+	}
+#endif
+	while (i < n && p[i] < 0x80) {
+		++i;
+	}
+	return i;
+}
+
+bool BSONValidator::isValidUTF8(const char* s, size_t n) {
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(s);
+	size_t i = 0;
+	for (;;) {
+		i += asciiPrefix(p + i, n - i);
+		if (i == n) {
+			return true;
+		}
+		// Decode one multi-byte sequence, bounding the second byte per RFC 3629 table 3-7.
+		unsigned char c = p[i];
+		unsigned char lo = 0x80, hi = 0xBF;
+		size_t length;
+		if (c < 0xC2) {
+			return false; // A continuation byte, or an overlong two byte form.
+		} else if (c < 0xE0) {
+			length = 2;
+		} else if (c < 0xF0) {
+			length = 3;
+			if (c == 0xE0) {
+				lo = 0xA0;
+			} else if (c == 0xED) {
+				hi = 0x9F; // Surrogates.
+			}
+		} else if (c < 0xF5) {
+			length = 4;
+			if (c == 0xF0) {
+				lo = 0x90;
+			} else if (c == 0xF4) {
+				hi = 0x8F; // Over U+10FFFF.
+			}
+		} else {
+			return false;
+		}
+		if (n - i < length || p[i + 1] < lo || p[i + 1] > hi) {
+			return false;
+		}
+		for (size_t j = 2; j < length; j++) {
+			if ((p[i + j] & 0xC0) != 0x80) {
+				return false;
+			}
+		}
+		i += length;
+	}
+}
+
+//----------------------------------------------------------------------------
+
+bool BSONValidator::validate(const char* data, size_t available) {
+	base = data;
+	error = NULL;
+	errorOffset = 0;
+	return validateObject(data, data + available, 0);
+}
+
+bool BSONValidator::validateCString(const char*& p, const char* end) {
+	const char* nul = static_cast<const char*>(memchr(p, '\0', end - p));
+	if (nul == NULL) {
+		return fail(p, "Unterminated key or C string");
+	}
+	if (!isValidUTF8(p, nul - p)) {
+		return fail(p, "Invalid UTF-8 in key or C string");
+	}
+	p = nul + 1;
+	return true;
+}
+
+bool BSONValidator::validateString(const char*& p, const char* end) {
+	if (end - p < 4) {
+		return fail(p, "Truncated string length");
+	}
+	int32_t length = readInt32(p);
+	if (length < 1 || length > end - p - 4) {
+		return fail(p, "String length out of bounds");
+	}
+	p += 4;
+	if (p[length - 1] != '\0') {
+		return fail(p + length - 1, "Unterminated string");
+	}
+	if (!isValidUTF8(p, length - 1)) {
+		return fail(p, "Invalid UTF-8 in string");
+	}
+	p += length;
+	return true;
+}
+
+bool BSONValidator::validateObject(const char* p, const char* end, int depth) {
+	if (depth > maxDepth) {
+		return fail(p, "Nesting too deep");
+	}
+	if (end - p < 5) {
+		return fail(p, "Truncated object length");
+	}
+	int32_t length = readInt32(p);
+	if (length < 5 || length > end - p) {
+		return fail(p, "Object length out of bounds");
+	}
+	end = p + length - 1; // The terminating EOO.
+	if (*end != '\0') {
+		return fail(end, "Unterminated object");
+	}
+	p += 4;
+	while (p < end) {
+		unsigned char type = *p++;
+		if (!validateCString(p, end)) {
+			return false;
+		}
+		size_t fixed = 0;
+		switch (type) {
+		case 0x01: // Double
+		case 0x09: // Date
+		case 0x11: // Timestamp
+		case 0x12: // Int64
+			fixed = 8;
+			break;
+		case 0x02: // String
+		case 0x0D: // Code
+		case 0x0E: // Symbol
+			if (!validateString(p, end)) {
+				return false;
+			}
+			break;
+		case 0x03: // Object
+		case 0x04: // Array
+			if (!validateObject(p, end, depth + 1)) {
+				return false;
+			}
+			p += readInt32(p);
+			break;
+		case 0x05: // BinData
+			if (end - p < 5 || readInt32(p) < 0 || readInt32(p) > end - p - 5) {
+				return fail(p, "Binary length out of bounds");
+			}
+			p += 5 + readInt32(p);
+			break;
+		case 0x06: // Undefined
+		case 0x0A: // Null
+		case 0x7F: // MaxKey
+		case 0xFF: // MinKey
+			break;
+		case 0x07: // OID
+			fixed = 12;
+			break;
+		case 0x08: // Bool
+			if (p < end && (unsigned char)*p > 1) {
+				return fail(p, "Invalid boolean");
+			}
+			fixed = 1;
+			break;
+		case 0x0B: // Regex
+			if (!validateCString(p, end) || !validateCString(p, end)) {
+				return false;
+			}
+			break;
+		case 0x0C: // DBPointer
+			if (!validateString(p, end)) {
+				return false;
+			}
+			fixed = 12;
+			break;
+		case 0x0F: // Code with scope
+			{
+				const char* start = p;
+				if (end - p < 4 || readInt32(p) < 14 || readInt32(p) > end - p) {
+					return fail(p, "Code with scope length out of bounds");
+				}
+				const char* scopeEnd = p + readInt32(p);
+				p += 4;
+				if (!validateString(p, scopeEnd) || !validateObject(p, scopeEnd, depth + 1)) {
+					return false;
+				}
+				p += readInt32(p);
+				if (p != scopeEnd) {
+					return fail(start, "Code with scope length mismatch");
+				}
+			}
+			break;
+		case 0x10: // Int32
+			fixed = 4;
+			break;
+		case 0x13: // Decimal128
+			fixed = 16;
+			break;
+		default:
+			return fail(p, "Unknown element type");
+		}
+		if ((size_t)(end - p) < fixed) {
+			return fail(p, "Truncated element value");
+		}
+		p += fixed;
+	}
+	if (p != end) {
+		return fail(end, "Element overruns object");
+	}
+	return true;
+}
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
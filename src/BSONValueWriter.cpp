@@ -0,0 +1,121 @@
+/*!
+ * \file BSONValueWriter.cpp
+ * \brief BSON Element Value Output Implementation
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#include <cmath>
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+#include "BSONValueWriter.hpp"
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * The least %g precision used, DBL_DIG, below which every decimal reads back as itself.
+ */
+static const int MIN_PRECISION = 15;
+
+//----------------------------------------------------------------------------
+
+size_t BSONValueWriter::formatDouble(double value, char* buf) {
+	if (std::isnan(value) || std::isinf(value)) {
+		return snprintf(buf, DOUBLE_BUFFER_SIZE, "%g", value);
+	}
+	size_t n = 0;
+#if __cplusplus >= 201703L
+	// The shortest digits as [-]d[.ddd]e(+|-)XX, laid out as %g would with a precision of at least MIN_PRECISION.
+	char sci[DOUBLE_BUFFER_SIZE];
+	char* sciEnd = std::to_chars(sci, sci + sizeof(sci), value, std::chars_format::scientific).ptr;
+	const char* p = sci;
+	if (*p == '-') {
+		buf[n++] = *p++;
+	}
+	char digits[20];
+	int digitCount = 0;
+	for (; *p != 'e'; p++) {
+		if (*p != '.') {
+			digits[digitCount++] = *p;
+		}
+	}
+	int exponent = 0;
+	for (const char* x = p + 2; x < sciEnd; x++) {
+		exponent = exponent * 10 + (*x - '0');
+	}
+	if (p[1] == '-') {
+		exponent = -exponent;
+	}
+	if (exponent < -4 || exponent >= std::max(digitCount, MIN_PRECISION)) {
+		memcpy(buf, sci, sciEnd - sci);
+		n = sciEnd - sci;
+	} else if (exponent < 0) {
+		buf[n++] = '0';
+		buf[n++] = '.';
+		for (int z = -1; z > exponent; z--) {
+			buf[n++] = '0';
+		}
+		memcpy(buf + n, digits, digitCount);
+		n += digitCount;
+	} else {
+		for (int d = 0; d <= exponent; d++) {
+			buf[n++] = d < digitCount ? digits[d] : '0';
+		}
+		if (digitCount > exponent + 1) {
+			buf[n++] = '.';
+			memcpy(buf + n, digits + exponent + 1, digitCount - exponent - 1);
+			n += digitCount - exponent - 1;
+		}
+	}
+#else
+	// Subnormals carry fewer significant bits, so fewer than MIN_PRECISION digits may be the shortest.
+	const int leastPrecision = std::fabs(value) < DBL_MIN ? 1 : MIN_PRECISION;
+	for (int precision = leastPrecision; precision <= 17; precision++) {
+		n = snprintf(buf, DOUBLE_BUFFER_SIZE, "%.*g", precision, value);
+		if (strtod(buf, NULL) == value) {
+			break;
+		}
+	}
+#endif
+	if (memchr(buf, '.', n) == NULL && memchr(buf, 'e', n) == NULL) {
+		buf[n++] = '.';
+		buf[n++] = '0';
+	}
+	return n;
+}
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
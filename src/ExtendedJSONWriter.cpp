@@ -0,0 +1,385 @@
+/*!
+ * \file ExtendedJSONWriter.cpp
+ * \brief MongoDB Extended JSON v2 Value Output Implementation
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <stdint.h>
+
+#include "ExtendedJSONWriter.hpp"
+#include "BSONValueWriter.hpp"
+#include "JSONStringEncoder.hpp"
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+static int32_t readInt32(const char* p) {
+	int32_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static int64_t readInt64(const char* p) {
+	int64_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static void writeHexLower(OutputSink& sink, const char* p, size_t n) {
+	static const char HEX[] = "0123456789abcdef";
+	for (size_t i = 0; i < n; i++) {
+		unsigned char c = p[i];
+		sink << HEX[c >> 4] << HEX[c & 0xF];
+	}
+}
+
+static void writeOid(OutputSink& sink, const char* oid) {
+	sink << "{\"$oid\": \"";
+	writeHexLower(sink, oid, 12);
+	sink << "\"}";
+}
+
+/*!
+ * \brief Write an integer as a JSON string, as the canonical $numberInt and $numberLong do.
+ */
+static void writeQuotedInteger(OutputSink& sink, long long value) {
+	sink << '"' << value << '"';
+}
+
+//----------------------------------------------------------------------------
+
+void ExtendedJSONWriter::writeCanonicalDouble(OutputSink& sink, double value) {
+	sink << "{\"$numberDouble\": \"";
+	if (std::isnan(value)) {
+		sink << "NaN";
+	} else if (std::isinf(value)) {
+		sink << (value < 0 ? "-Infinity" : "Infinity");
+	} else {
+		BSONValueWriter::writeDouble(sink, value);
+	}
+	sink << "\"}";
+}
+
+void ExtendedJSONWriter::writeDate(OutputSink& sink, long long millis) {
+	if (mode == CANONICAL || millis < 0 || millis > MAX_ISO_DATE) {
+		sink << "{\"$date\": {\"$numberLong\": ";
+		writeQuotedInteger(sink, millis);
+		sink << "}}";
+		return;
+	}
+	char buf[DATE_BUFFER_SIZE];
+	size_t n = formatISODate(millis, buf);
+	sink << "{\"$date\": \"";
+	sink.write(buf, n);
+	sink << "\"}";
+}
+
+void ExtendedJSONWriter::write(OutputSink& sink, const BSONElement& e) {
+	const char* v = e.value();
+	switch ((int)e.type()) {
+	case BSONType::NumberDouble:
+		{
+			double d = e.number();
+			if (mode == RELAXED && std::isfinite(d)) {
+				BSONValueWriter::writeDouble(sink, d);
+			} else {
+				writeCanonicalDouble(sink, d);
+			}
+		}
+		break;
+	case BSONType::String:
+		JSONStringEncoder::writeQuoted(sink, v + 4, readInt32(v) - 1);
+		break;
+	case BSONType::Object:
+	case BSONType::Array:
+		writeObject(sink, e.embeddedObject(), e.type() == BSONType::Array);
+		break;
+	case BSONType::BinData:
+		{
+			int32_t length = readInt32(v);
+			unsigned char subType = v[4];
+			const char* data = v + 5;
+			if (subType == 2 && length >= 4) { // The old binary subtype repeats the length.
+				data += 4;
+				length -= 4;
+			}
+			sink << "{\"$binary\": {\"base64\": \"";
+			writeBase64(sink, data, length);
+			sink << "\", \"subType\": \"";
+			writeHexLower(sink, (const char*)&subType, 1);
+			sink << "\"}}";
+		}
+		break;
+	case BSONType::Undefined:
+		sink << "{\"$undefined\": true}";
+		break;
+	case BSONType::jstOID:
+		writeOid(sink, v);
+		break;
+	case BSONType::Bool:
+		sink << (*v ? "true" : "false");
+		break;
+	case BSONType::Date:
+		writeDate(sink, readInt64(v));
+		break;
+	case BSONType::jstNULL:
+		sink << "null";
+		break;
+	case BSONType::RegEx:
+		{
+			size_t patternLength = strlen(v);
+			string options(v + patternLength + 1);
+			std::sort(options.begin(), options.end());
+			sink << "{\"$regularExpression\": {\"pattern\": ";
+			JSONStringEncoder::writeQuoted(sink, v, patternLength);
+			sink << ", \"options\": ";
+			JSONStringEncoder::writeQuoted(sink, options);
+			sink << "}}";
+		}
+		break;
+	case BSONType::DBRef: // The deprecated DBPointer: a namespace and an ObjectId.
+		{
+			int32_t length = readInt32(v);
+			sink << "{\"$dbPointer\": {\"$ref\": ";
+			JSONStringEncoder::writeQuoted(sink, v + 4, length - 1);
+			sink << ", \"$id\": ";
+			writeOid(sink, v + 4 + length);
+			sink << "}}";
+		}
+		break;
+	case BSONType::Code:
+		sink << "{\"$code\": ";
+		JSONStringEncoder::writeQuoted(sink, v + 4, readInt32(v) - 1);
+		sink << '}';
+		break;
+	case BSONType::Symbol:
+		sink << "{\"$symbol\": ";
+		JSONStringEncoder::writeQuoted(sink, v + 4, readInt32(v) - 1);
+		sink << '}';
+		break;
+	case BSONType::CodeWScope: // Total length, code string, scope document.
+		{
+			int32_t codeLength = readInt32(v + 4);
+			sink << "{\"$code\": ";
+			JSONStringEncoder::writeQuoted(sink, v + 8, codeLength - 1);
+			sink << ", \"$scope\": ";
+			writeObject(sink, BSONObj(v + 8 + codeLength), false);
+			sink << '}';
+		}
+		break;
+	case BSONType::NumberInt:
+		if (mode == RELAXED) {
+			sink << readInt32(v);
+		} else {
+			sink << "{\"$numberInt\": ";
+			writeQuotedInteger(sink, readInt32(v));
+			sink << '}';
+		}
+		break;
+	case BSONType::Timestamp: // The increment, then the seconds.
+		{
+			uint32_t increment, seconds;
+			memcpy(&increment, v, 4);
+			memcpy(&seconds, v + 4, 4);
+			sink << "{\"$timestamp\": {\"t\": " << (long long)seconds << ", \"i\": " << (long long)increment << "}}";
+		}
+		break;
+	case BSONType::NumberLong:
+		if (mode == RELAXED) {
+			sink << (long long)readInt64(v);
+		} else {
+			sink << "{\"$numberLong\": ";
+			writeQuotedInteger(sink, readInt64(v));
+			sink << '}';
+		}
+		break;
+	case NUMBER_DECIMAL:
+		{
+			char buf[DECIMAL128_BUFFER_SIZE];
+			sink << "{\"$numberDecimal\": \"";
+			sink.write(buf, formatDecimal128(v, buf));
+			sink << "\"}";
+		}
+		break;
+	case BSONType::MinKey:
+		sink << "{\"$minKey\": 1}";
+		break;
+	case BSONType::MaxKey:
+		sink << "{\"$maxKey\": 1}";
+		break;
+	default:
+		throw std::logic_error(string("ISE: Undefined BSON type ") + to_string((int)e.type()) + " for Extended JSON!");
+	}
+}
+
+void ExtendedJSONWriter::writeObject(OutputSink& sink, const BSONObj& object, bool isArray) {
+	sink << (isArray ? '[' : '{');
+	BSONObjIterator i(object);
+	bool first = true;
+	while (i.more()) {
+		BSONElement e = i.next();
+		if (!first) {
+			sink << ", ";
+		}
+		first = false;
+		if (!isArray) {
+			JSONStringEncoder::writeQuoted(sink, e.fieldNameStringData());
+			sink << ": ";
+		}
+		write(sink, e);
+	}
+	sink << (isArray ? ']' : '}');
+}
+
+void ExtendedJSONWriter::writeBase64(OutputSink& sink, const char* p, size_t n) {
+	static const char BASE64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+	char quad[4];
+	size_t i = 0;
+	for (; i + 3 <= n; i += 3) {
+		uint32_t bits = (u[i] << 16) | (u[i + 1] << 8) | u[i + 2];
+		quad[0] = BASE64[bits >> 18];
+		quad[1] = BASE64[(bits >> 12) & 0x3F];
+		quad[2] = BASE64[(bits >> 6) & 0x3F];
+		quad[3] = BASE64[bits & 0x3F];
+		sink.write(quad, 4);
+	}
+	if (i < n) {
+		uint32_t bits = u[i] << 16;
+		if (i + 1 < n) {
+			bits |= u[i + 1] << 8;
+		}
+		quad[0] = BASE64[bits >> 18];
+		quad[1] = BASE64[(bits >> 12) & 0x3F];
+		quad[2] = i + 1 < n ? BASE64[(bits >> 6) & 0x3F] : '=';
+		quad[3] = '=';
+		sink.write(quad, 4);
+	}
+}
+
+size_t ExtendedJSONWriter::formatISODate(long long millis, char* buf) {
+	// Civil date from days since the epoch, proleptic Gregorian; see H. Hinnant, "chrono-Compatible Low-Level Date Algorithms".
+	long long days = millis / 86400000;
+	int msOfDay = millis % 86400000;
+	long long z = days + 719468;
+	long long era = z / 146097;
+	long long doe = z - era * 146097;
+	long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	long long mp = (5 * doy + 2) / 153;
+	int day = doy - (153 * mp + 2) / 5 + 1;
+	int month = mp < 10 ? mp + 3 : mp - 9;
+	int year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+	return snprintf(buf, DATE_BUFFER_SIZE, "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ", year, month, day,
+			msOfDay / 3600000, msOfDay / 60000 % 60, msOfDay / 1000 % 60, msOfDay % 1000);
+}
+
+size_t ExtendedJSONWriter::formatDecimal128(const char* bytes, char* buf) {
+	const uint64_t low = readInt64(bytes);
+	const uint64_t high = readInt64(bytes + 8);
+	const bool negative = (high >> 63) != 0;
+	size_t n = 0;
+	const uint64_t combination = (high >> 58) & 0x1F;
+	if (combination == 0x1F) {
+		memcpy(buf, "NaN", 3);
+		return 3;
+	}
+	if (negative) {
+		buf[n++] = '-';
+	}
+	if (combination == 0x1E) {
+		memcpy(buf + n, "Infinity", 8);
+		return n + 8;
+	}
+
+	// Decode the biased exponent and the coefficient, a non-canonical coefficient being zero.
+	int exponent;
+	unsigned __int128 coefficient;
+	if (((high >> 61) & 3) == 3) {
+		exponent = (high >> 47) & 0x3FFF;
+		coefficient = 0; // The implied 100 prefix exceeds the 34 digit maximum.
+	} else {
+		exponent = (high >> 49) & 0x3FFF;
+		coefficient = ((unsigned __int128)(high & 0x1FFFFFFFFFFFFULL) << 64) | low;
+		const unsigned __int128 MAX_COEFFICIENT = (unsigned __int128)10000000000000000ULL * 1000000000000000000ULL - 1; // 10^34 - 1.
+		if (coefficient > MAX_COEFFICIENT) {
+			coefficient = 0;
+		}
+	}
+	exponent -= 6176;
+
+	char digits[40];
+	int digitCount = 0;
+	do {
+		digits[digitCount++] = (char)('0' + (int)(coefficient % 10));
+		coefficient /= 10;
+	} while (coefficient != 0);
+	std::reverse(digits, digits + digitCount);
+
+	const int adjusted = exponent + digitCount - 1;
+	if (exponent <= 0 && adjusted >= -6) { // Plain notation.
+		if (exponent == 0) {
+			memcpy(buf + n, digits, digitCount);
+			n += digitCount;
+		} else {
+			const int fraction = -exponent;
+			if (digitCount <= fraction) {
+				buf[n++] = '0';
+				buf[n++] = '.';
+				for (int z = digitCount; z < fraction; z++) {
+					buf[n++] = '0';
+				}
+				memcpy(buf + n, digits, digitCount);
+				n += digitCount;
+			} else {
+				memcpy(buf + n, digits, digitCount - fraction);
+				n += digitCount - fraction;
+				buf[n++] = '.';
+				memcpy(buf + n, digits + digitCount - fraction, fraction);
+				n += fraction;
+			}
+		}
+	} else { // Scientific notation.
+		buf[n++] = digits[0];
+		if (digitCount > 1) {
+			buf[n++] = '.';
+			memcpy(buf + n, digits + 1, digitCount - 1);
+			n += digitCount - 1;
+		}
+		n += snprintf(buf + n, DECIMAL128_BUFFER_SIZE - n, "E%c%d", adjusted < 0 ? '-' : '+', std::abs(adjusted));
+	}
+	return n;
+}
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
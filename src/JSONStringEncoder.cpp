@@ -0,0 +1,128 @@
+/*!
+ * \file JSONStringEncoder.cpp
+ * \brief JSON String Escaping Implementation
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "JSONStringEncoder.hpp"
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+/*!
+ * \return True if the byte must be escaped in a JSON string.
+ */
+
+static inline bool needsEscape(unsigned char c) {
+	return c < 0x20 || c == '"' || c == '\\';
+}
+
+//----------------------------------------------------------------------------
+
+size_t JSONStringEncoder::cleanPrefix(const unsigned char* p, size_t n) {
+	size_t i = 0;
+#if defined(__AVX2__)
+	{
+		const __m256i quote = _mm256_set1_epi8('"');
+		const __m256i backslash = _mm256_set1_epi8('\\');
+		const __m256i control = _mm256_set1_epi8(0x1F);
+		for (; i + 32 <= n; i += 32) {
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+			__m256i special = _mm256_or_si256(
+					_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)),
+					_mm256_cmpeq_epi8(_mm256_max_epu8(v, control), control)); // v <= 0x1F unsigned.
+			int mask = _mm256_movemask_epi8(special);
+			if (mask) {
+				return i + __builtin_ctz(mask);
+			}
+		}
+	}
+#endif
+#if defined(__SSE2__)
+	{
+		const __m128i quote = _mm_set1_epi8('"');
+		const __m128i backslash = _mm_set1_epi8('\\');
+		const __m128i control = _mm_set1_epi8(0x1F);
+		for (; i + 16 <= n; i += 16) {
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+			__m128i special = _mm_or_si128(
+					_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+					_mm_cmpeq_epi8(_mm_max_epu8(v, control), control)); // v <= 0x1F unsigned.
+			int mask = _mm_movemask_epi8(special);
+			if (mask) {
+				return i + __builtin_ctz(mask);
+			}
+		}
+	}
+#endif
+	while (i < n && !needsEscape(p[i])) {
+		++i;
+	}
+	return i;
+}
+
+void JSONStringEncoder::writeEscaped(OutputSink& sink, const char* p, size_t n) {
+	static const char HEX[] = "0123456789abcdef";
+	const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+	size_t i = 0;
+	for (;;) {
+		size_t clean = cleanPrefix(u + i, n - i);
+		sink.write(p + i, clean);
+		i += clean;
+		if (i == n) {
+			return;
+		}
+		unsigned char c = u[i++];
+		switch (c) {
+		case '"':	sink.write("\\\"", 2); break;
+		case '\\':	sink.write("\\\\", 2); break;
+		case '\b':	sink.write("\\b", 2); break;
+		case '\f':	sink.write("\\f", 2); break;
+		case '\n':	sink.write("\\n", 2); break;
+		case '\r':	sink.write("\\r", 2); break;
+		case '\t':	sink.write("\\t", 2); break;
+		default:
+			{
+				char escape[6] = { '\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF] };
+				sink.write(escape, sizeof(escape));
+			}
+			break;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
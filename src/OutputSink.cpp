@@ -0,0 +1,144 @@
+/*!
+ * \file OutputSink.cpp
+ * \brief Buffered Renderer Output Implementation
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#include <sys/uio.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "OutputSink.hpp"
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+static const size_t MIN_BUFFER_SIZE = 256;
+
+/*!
+ * \brief Write every byte described by an iovec array, resuming after partial writes and interrupts.
+ * \param[in] fd The file descriptor.
+ * \param[in,out] iov The buffers, consumed as they are written.
+ * \param[in] count The count of buffers.
+ * \throws std::runtime_error If the write fails.
+ */
+
+static void writeAll(int fd, struct iovec* iov, int count) {
+	while (count > 0) {
+		ssize_t n = ::writev(fd, iov, count);
+		if (n < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			throw std::runtime_error(string("Cannot write output: ") + strerror(errno));
+		}
+		while (count > 0 && (size_t) n >= iov->iov_len) {
+			n -= iov->iov_len;
+			iov++;
+			count--;
+		}
+		if (count > 0) {
+			iov->iov_base = (char*) iov->iov_base + n;
+			iov->iov_len -= n;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------
+
+OutputSink::OutputSink(int pfd, bool powned, size_t bufferSize) :
+		fd(pfd), ownsFd(powned), buffer(std::max(bufferSize, MIN_BUFFER_SIZE)), used(0) {}
+
+OutputSink::OutputSink() : fd(-1), ownsFd(false), buffer(MIN_BUFFER_SIZE), used(0) {}
+
+OutputSink::~OutputSink() {
+	try {
+		flush();
+	} catch (std::runtime_error& e) { // Already unwinding, or the output is gone.
+	}
+	if (ownsFd) {
+		::close(fd);
+	}
+}
+
+void OutputSink::overflow(const char* p, size_t n) {
+	if (fd < 0) { // Memory sink, grow the buffer.
+		buffer.resize(std::max(buffer.size() * 2, used + n));
+	} else if (n < buffer.size()) { // Make room for the bytes.
+		flush();
+	} else { // Write the buffered bytes and the bytes without copying them.
+		struct iovec iov[2];
+		iov[0].iov_base = buffer.data();
+		iov[0].iov_len = used;
+		iov[1].iov_base = (void*) p;
+		iov[1].iov_len = n;
+		used = 0;
+		writeAll(fd, iov, 2);
+		return;
+	}
+	memcpy(buffer.data() + used, p, n);
+	used += n;
+}
+
+void OutputSink::trim(size_t capacity) {
+	used = 0;
+	if (buffer.size() > capacity) {
+		vector<char>(std::max(capacity, MIN_BUFFER_SIZE)).swap(buffer);
+	}
+}
+
+void OutputSink::flush() {
+	if (fd >= 0 && used > 0) {
+		struct iovec iov;
+		iov.iov_base = buffer.data();
+		iov.iov_len = used;
+		used = 0;
+		writeAll(fd, &iov, 1);
+	}
+}
+
+OutputSink& OutputSink::operator<<(long long value) {
+	char digits[24];
+	char* end = digits + sizeof(digits);
+	char* p = end;
+	unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long) value : (unsigned long long) value;
+	do {
+		*--p = (char) ('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude != 0);
+	if (value < 0) {
+		*--p = '-';
+	}
+	write(p, end - p);
+	return *this;
+}
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
@@ -46,6 +46,12 @@ static void mapperInit() {
 		styleMapper.insert("tree",        STYLE_TREE);
 		styleMapper.insert("json",        STYLE_JSON);
 		styleMapper.insert("jsonpacked",  STYLE_JSONPACKED);
+		styleMapper.insert("ejson",       STYLE_EJSON);
+		styleMapper.insert("ejsonrelaxed", STYLE_EJSONRELAXED);
+		styleMapper.insert("ndjson",      STYLE_NDJSON);
+		styleMapper.insert("csv",         STYLE_CSV);
+		styleMapper.insert("tsv",         STYLE_TSV);
+		styleMapper.insert("arrow",       STYLE_ARROW);
 		typeMapper.insert("none", TYPE_NONE);
 		typeMapper.insert("name", TYPE_NAME);
 		typeMapper.insert("desc", TYPE_DESC);
@@ -54,7 +60,23 @@ static void mapperInit() {
 	}
 }
 
-Parameters::Parameters() : valid(false), port(DEFAULT_PORT), scalarFirst(false), style(STYLE_DOTTED), typeMask(TYPE_ALL) {
+/*!
+ * \brief Reject an integer option value below its minimum.
+ * \param[in] name The option name.
+ * \param[in] value The option value.
+ * \param[in] minimum The least valid value.
+ * \throws po::invalid_option_value If the value is less than the minimum.
+ */
+
+static void checkMinimum(const char* name, int value, int minimum) {
+	if (value < minimum) {
+		po::invalid_option_value e(to_string(value));
+		e.set_option_name(name);
+		throw e;
+	}
+}
+
+Parameters::Parameters() : valid(false), port(DEFAULT_PORT), scalarFirst(false), maxDepth(0), maxArrayElems(0), bufferSize(DEFAULT_BUFFER_SIZE), threads(1), splitElems(DEFAULT_SPLIT_ELEMS), style(STYLE_DOTTED), typeMask(TYPE_ALL), sampleSize(DEFAULT_SAMPLE_SIZE) {
 	mapperInit();
 }
 
@@ -100,6 +122,7 @@ int Parameters::parse(int ac, char* av[])
             ("version,v", "print version string")
             ("debug,d", "print debugging info")
             ("stack,q", "print stack debugging info")
+            ("trusted", "skip validation of documents read from --cache files")
             ("config,c", po::value<string>(&config_file)->default_value(DEFAULT_CONFIGURATION_FILE),
                   "path of configuration file. Default configuration file: " DEFAULT_CONFIGURATION_FILE)
             ;
@@ -111,17 +134,39 @@ int Parameters::parse(int ac, char* av[])
                   "MongoDB server host name: <host>[:port]")
             ("port,p", po::value<int>(&port)->default_value(DEFAULT_PORT),
                  "MongoDB server port number.")
+            ("cache,k", po::value<string>(&cacheDir),
+                 "Directory for local copies of scanned collections. A copy is reused while the collection's count and greatest _id are unchanged.")
             ;
 
         // Options that will be allowed both on command line and in the configuration file.
         po::options_description oformat("Output Format Options");
         oformat.add_options()
 					("style,s", po::value<StyleParam>(&style)->default_value(STYLE_DOTTED),
-		                  "Output Style: {dotted,tree,json,jsonpacked}.")
+		                  "Output Style: {dotted,tree,json,jsonpacked,ejson,ejsonrelaxed,ndjson,csv,tsv,arrow}.")
 	      			("type,t", po::value<TypeParamMask>(&typeMask)->default_value(TYPE_ALL),
                           "BSON Type: {none,name,desc,code,all}.")
                     ("scalarfirst,f", po::value<bool>(&scalarFirst)->default_value(false),
                           "Output scalar objects elements before any embedded objects or arrays.")
+                    ("max-depth", po::value<int>(&maxDepth)->default_value(0),
+                          "Summarize objects and arrays nested deeper than this level, the document being level 1. 0: No limit.")
+                    ("max-array-elems", po::value<int>(&maxArrayElems)->default_value(0),
+                          "Summarize the elements of each array after the first N. 0: No limit.")
+                    ("bufsize", po::value<int>(&bufferSize)->default_value(DEFAULT_BUFFER_SIZE),
+                          "Size in bytes of the buffers through which large string and binary values are written.")
+                    ("threads,j", po::value<int>(&threads)->default_value(1),
+                          "Count of threads rendering concurrently.")
+                    ("split-elems", po::value<int>(&splitElems)->default_value(DEFAULT_SPLIT_ELEMS),
+                          "Split arrays of at least this many elements between the --threads.")
+                    ("include,i", po::value<vector<string>>(&includePaths)->composing(),
+                          "Output only the comma separated dotted paths, '*' matches any key, i.e., \"payload.meta,*.id\".")
+                    ("exclude,x", po::value<vector<string>>(&excludePaths)->composing(),
+                          "Omit the comma separated dotted paths, '*' matches any key.")
+                    ("output,o", po::value<vector<string>>(&outputSpecs)->composing(),
+                          "Output Style and File: <style>[:<file>], repeat with distinct files to render several styles from one scan. Replaces --style. Default file: '-' (stdout), for one output at most.")
+                    ("columns", po::value<vector<string>>(&columnSpecs)->composing(),
+                          "The comma separated dotted paths output as csv and tsv columns, array indexes as keys, i.e., \"_id,items.0.name\".")
+                    ("sample", po::value<int>(&sampleSize)->default_value(DEFAULT_SAMPLE_SIZE),
+                          "Count of documents whose dotted paths are the csv and tsv columns, unless --columns are given, and whose types are the arrow schema.")
             ;
 
         // Hidden options, will be allowed both on command line and in config file, but will not be shown to the user.
@@ -179,6 +224,50 @@ int Parameters::parse(int ac, char* av[])
             exit(0);
         }
 
+        for (const string& paths : includePaths) {
+        	pathFilter.addInclude(paths);
+        }
+        for (const string& paths : excludePaths) {
+        	pathFilter.addExclude(paths);
+        }
+
+        for (const string& spec : outputSpecs) {
+        	size_t colon = spec.find(':');
+        	OutputParam o;
+        	string styleName(spec, 0, colon);
+        	o.style = styleMapper.find(styleName, STYLE_UNDEF);
+        	o.path = colon == string::npos || colon + 1 == spec.length() ? string("-") : spec.substr(colon + 1);
+        	// Each output needs a file of its own, the renderers' events are interleaved token by token.
+        	bool repeated = std::any_of(outputs.begin(), outputs.end(), [&o] (const OutputParam& p) { return p.path == o.path; });
+        	if (o.style == STYLE_UNDEF || repeated) {
+        		po::invalid_option_value e(spec);
+        		e.set_option_name("output");
+        		throw e;
+        	}
+        	outputs.push_back(o);
+        }
+
+        for (const string& spec : columnSpecs) {
+        	size_t start = 0;
+        	while (start <= spec.length()) {
+        		size_t comma = spec.find(',', start);
+        		if (comma == string::npos) {
+        			comma = spec.length();
+        		}
+        		if (comma > start) {
+        			columns.push_back(spec.substr(start, comma - start));
+        		}
+        		start = comma + 1;
+        	}
+        }
+
+        checkMinimum("max-depth", maxDepth, 0);
+        checkMinimum("max-array-elems", maxArrayElems, 0);
+        checkMinimum("bufsize", bufferSize, 1);
+        checkMinimum("threads", threads, 1);
+        checkMinimum("split-elems", splitElems, 0);
+        checkMinimum("sample", sampleSize, 1);
+
         valid = true;
 
         if (isDebug()) {
@@ -201,7 +290,21 @@ ostream& operator <<(ostream& os, Parameters& p) {
     os << "style:" << p.style << "\n";
     os << "typeMask:" << p.typeMask << "\n";
     os << "scalarFirst:" << p.scalarFirst << "\n";
+    os << "maxDepth:" << p.maxDepth << "\n";
+    os << "maxArrayElems:" << p.maxArrayElems << "\n";
+    os << "bufferSize:" << p.bufferSize << "\n";
+    os << "threads:" << p.threads << "\n";
+    os << "splitElems:" << p.splitElems << "\n";
     os << "dbCollection:" << p.dbCollection << "\n";
+    os << "cacheDir:" << p.cacheDir << "\n";
+    for (const string& c : p.columns) {
+        os << "column:" << c << "\n";
+    }
+    os << "sampleSize:" << p.sampleSize << "\n";
+    for (const OutputParam& o : p.outputs) {
+        os << "output:" << o.style << ":" << o.path << "\n";
+    }
+    os << p.pathFilter;
 //    os << "query:" << p.query << "\n";
 //    os << "projection:" << p.projection << "\n";
     return os;
@@ -0,0 +1,136 @@
+/*!
+ * \file WorkerPool.cpp
+ * \brief Persistent Worker Thread Pool Implementation
+ *
+ * \author MongoType Contributors
+ * \copyright Copyright &copy; 2026 by the MongoType Contributors<br/><br/>
+ *
+ *   <b>License:</b> <i>Free Software Foundation’s GNU AGPL v3.0.</i><br/>
+ *
+ * This program is free software: you can redistribute it and/or modify<br/>
+ * it under the terms of the GNU Affero General Public License as<br/>
+ * published by the Free Software Foundation, either version 3 of the<br/>
+ * License, or (at your option) any later version.<br/>
+ *
+ * This program is distributed in the hope that it will be useful,<br/>
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of<br/>
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the<br/>
+ * GNU Affero General Public License for more details.<br/>
+ *
+ * You should have received a copy of the GNU Affero General Public License<br/>
+ * along with this program.  If not, see http://www.gnu.org/licenses/ .<br/>
+ *
+ * Creation Date: October 17, 2026
+ * Eclipse Project: MongoType
+ *
+ */
+
+//----------------------------------------------------------------------------
+
+#include "WorkerPool.hpp"
+
+//----------------------------------------------------------------------------
+
+namespace mongotype {
+
+//----------------------------------------------------------------------------
+
+WorkerPool::WorkerPool(int threadCount) : stopping(false) {
+	try {
+		for (int t = 0; t < threadCount; t++) {
+			threads.push_back(std::thread(&WorkerPool::work, this));
+		}
+	} catch (...) { // A joinable std::thread must not be destroyed.
+		stop();
+		throw;
+	}
+}
+
+WorkerPool::~WorkerPool() {
+	stop();
+}
+
+WorkerPool& WorkerPool::shared(int threadCount) {
+	static WorkerPool pool(threadCount);
+	return pool;
+}
+
+void WorkerPool::stop() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	jobReady.notify_all();
+	for (std::thread& t : threads) {
+		t.join();
+	}
+	threads.clear();
+}
+
+/*!
+ * \brief Claim and run the job's tasks until none are left.
+ * \param[in] job The job.
+ * \param[in] lock The held lock of the pool mutex, released while a task runs.
+ */
+
+void WorkerPool::runTasks(Job& job, std::unique_lock<std::mutex>& lock) {
+	while (job.next < job.count) {
+		const int i = job.next++;
+		lock.unlock();
+		try {
+			job.task(i);
+			lock.lock();
+		} catch (...) {
+			lock.lock();
+			if (!job.error) {
+				job.error = std::current_exception();
+			}
+			job.next = job.count; // Abandon the unclaimed tasks.
+		}
+	}
+}
+
+/*!
+ * \brief The pool thread body: run the tasks of the oldest job with unclaimed tasks until stopped.
+ */
+
+void WorkerPool::work() {
+	std::unique_lock<std::mutex> lock(mutex);
+	for (;;) {
+		jobReady.wait(lock, [&] () { return stopping || !jobs.empty(); });
+		if (stopping) {
+			return;
+		}
+		Job& job = *jobs.front();
+		if (job.next >= job.count) { // Every task is claimed, the submitting thread will wait for those still running.
+			jobs.pop_front();
+			continue;
+		}
+		job.active++;
+		runTasks(job, lock);
+		job.active--;
+		jobIdle.notify_all();
+	}
+}
+
+void WorkerPool::run(int count, const function<void(int)>& task) {
+	Job job(task, count);
+	std::unique_lock<std::mutex> lock(mutex);
+	if (!threads.empty() && count > 1) {
+		jobs.push_back(&job);
+		jobReady.notify_all();
+	}
+	runTasks(job, lock);
+	auto queued = std::find(jobs.begin(), jobs.end(), &job);
+	if (queued != jobs.end()) { // Not yet dropped by a pool thread.
+		jobs.erase(queued);
+	}
+	jobIdle.wait(lock, [&] () { return job.active == 0; });
+	if (job.error) {
+		std::rethrow_exception(job.error);
+	}
+}
+
+//----------------------------------------------------------------------------
+
+} /* namespace mongotype */
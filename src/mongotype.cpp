@@ -57,10 +57,14 @@
  *
  * This is a catch-all function that:
  *
- *  - Opens a connection to the MongoDB database and gets a cursor to the collection specified by the Parameters object.
- *  - Constructs an object that sub-classes mongotype::IBSONRenderer that corresponds to the current mongotype::StyleParam.
+ *  - Opens a connection to the MongoDB database and gets a cursor to the collection specified by the Parameters object,
+ *    or, given --cache, maps a mongotype::BSONScanCache file of a previous scan if the collection is unchanged.
+ *  - Constructs an object that sub-classes mongotype::IBSONRenderer that corresponds to the current mongotype::StyleParam,
+ *    or a mongotype::BSONCompositeRenderer fanning each parsed document out to one renderer per --output option,
+ *    or, given --threads, a mongotype::BSONParallelRenderer rendering each batch's documents concurrently in document order.
+ *    Each renderer writes to a mongotype::OutputSink buffering its output for the standard output or --output file descriptor.
  *  - Invokes the object's mongotype::IBSONRenderer::begin function once to initialize rendering.
- *  - Invokes the object's mongotype::IBSONRenderer::render function with each MongoDb document returned by the cursor.
+ *  - Invokes the object's mongotype::IBSONRenderer::renderBatch function with each batch of MongoDb documents returned by the cursor.
  *  - Invokes the object's mongotype::IBSONRenderer::end function once to finalize rendering.
  *
  * ##### Command Line Parameter Parsing:
@@ -84,28 +88,57 @@
  * The mechanics of decomposing BSON objects is encapsulated in the mongotype::BSONObjectParser class which relies on mongotype::IBSONObjectVisitor implementors described below.
  * It supplies the instance method mongotype::BSONObjectParser::parse as the entry point to initiate parsing of a mongo::BSONObj object.
  *
+ * mongotype::BSONParseCursor produces the same events in pull style, honouring the same parse options when constructed with the
+ * mongotype::Parameters: one event per call to mongotype::BSONParseCursor::next,
+ * so that several documents may be interleaved or merged and a parse may be abandoned early.
+ *
+ * mongotype::BSONEventTape records the events of one parse as a flat array of fixed size entries, which a
+ * mongotype::IBSONTapeRenderer walks linearly, so that the parse and the rendering of a document may run on different threads.
+ *
  * ##### Style Implementation Classes
  *
  * The following classes implement mongotype::IBSONRenderer and mongotype::IBSONObjectVisitor as described above:
  *
  *  - mongotype::BSONObjectTypeDump - Implements --style=tree
  *  - mongotype::BSONDotNotationDump - Implements --style=dotted
- *  - mongotype::JSONDump - Implements --style=json and --style=jsonpacked
+ *  - mongotype::JSONDump - Implements --style=json, --style=jsonpacked and --style=ndjson, and with mongotype::ExtendedJSONWriter
+ *    --style=ejson and --style=ejsonrelaxed
+ *  - mongotype::BSONTableDump - Implements --style=csv and --style=tsv
+ *  - mongotype::BSONArrowDump - Implements --style=arrow
  *
  *  #### Utility Classes:
  *
  *  - mongotype::BSONTypeMap - Decodes BSON Type codes into mnemonics and description strings.
  *  - mongotype::BSONTypeFormatter - Formats BSON Type Codes into strings per the current mongotype::Parameters::getTypeMask value.
  *  - mongotype::EnumMapper - Maps enumeration integers to their string equivalent.
+ *  - mongotype::BSONPathFilter - Selects the dotted key paths parsed per the --include and --exclude options.
+ *  - mongotype::BSONScanCache - Keeps a local copy of a collection scan per the --cache option.
+ *  - mongotype::BSONValidator - Validates documents read from --cache files unless --trusted is given.
+ *  - mongotype::OutputSink - Buffers renderer output for write(2) to a file descriptor, or in memory.
+ *  - mongotype::JSONStringEncoder - Escapes keys and string values as JSON string literals.
+ *  - mongotype::ExtendedJSONWriter - Writes values as canonical or relaxed MongoDB Extended JSON v2.
+ *  - mongotype::BSONDotPath - Builds dotted paths incrementally as documents are parsed.
+ *  - mongotype::ArrowIPCWriter - Writes the schema and record batch messages of an Apache Arrow IPC stream.
+ *  - mongotype::WorkerPool - Runs the ranges of arrays split between the --threads on persistent threads.
  */
 
 //----------------------------------------------------------------------------
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <mongotype.hpp>
 #include <Parameters.hpp>
+#include <OutputSink.hpp>
 #include <BSONTypeMap.hpp>
 #include <BSONObjectTypeDump.hpp>
 #include <BSONDotNotationDump.hpp>
 #include <JSONDump.hpp>
+#include <BSONTableDump.hpp>
+#include <BSONArrowDump.hpp>
+#include <BSONCompositeRenderer.hpp>
+#include <BSONParallelRenderer.hpp>
+#include <BSONScanCache.hpp>
+#include <BSONValidator.hpp>
 
 //----------------------------------------------------------------------------
 
@@ -137,6 +170,43 @@ const string LICENSE(
 
 //----------------------------------------------------------------------------
 
+/*!
+ * \brief Construct the renderer implementing an output style.
+ * \param[in] params The command line parameters.
+ * \param[in] style The output style.
+ * \param[in] docPrefixString The string prefixing each rendered document, i.e., the db.collection name.
+ * \return The dynamically allocated renderer, ownership passes to the caller.
+ * \throws std::logic_error If the style is undefined.
+ */
+
+static IBSONRenderer* createRenderer(Parameters& params, StyleParam style, string& docPrefixString) {
+	switch (style) {
+	case STYLE_DOTTED:
+		return new BSONDotNotationDump(params, docPrefixString);
+	case STYLE_TREE:
+		return new BSONObjectTypeDump(params, docPrefixString);
+	case STYLE_JSON:
+	case STYLE_JSONPACKED:
+		return new JSONDump(params, "  ");
+	case STYLE_EJSON:
+		return new JSONDump(params, "  ", new ExtendedJSONWriter(ExtendedJSONWriter::CANONICAL));
+	case STYLE_EJSONRELAXED:
+		return new JSONDump(params, "  ", new ExtendedJSONWriter(ExtendedJSONWriter::RELAXED));
+	case STYLE_NDJSON:
+		return new JSONDump(params, "", NULL, true);
+	case STYLE_CSV:
+		return new BSONTableDump(params, ',');
+	case STYLE_TSV:
+		return new BSONTableDump(params, '\t');
+	case STYLE_ARROW:
+		return new BSONArrowDump(params);
+	default:
+		throw std::logic_error("ISE: Undefined STYLE!");
+	}
+}
+
+//----------------------------------------------------------------------------
+
 void dumpCollection(Parameters& params) {
 	DBClientConnection c;
 	string hostPort(params.getHost());
@@ -160,33 +230,101 @@ void dumpCollection(Parameters& params) {
 //	docIndex += to_string(i++);
 //	docIndex += "}";
 
-	unique_ptr<DBClientCursor> cursor = c.query(params.getDbCollection(), BSONObj());
+	cout.flush(); // The renderers write to the standard output file descriptor directly, after any debug output.
 
+	unique_ptr<OutputSink> sink; // Declared before the renderer so the sink is destroyed last.
 	unique_ptr<IBSONRenderer> renderer;
-	switch (params.getStyle()) {
-	case STYLE_DOTTED:
-		renderer = unique_ptr<IBSONRenderer>(new BSONDotNotationDump(params, docPrefixString));
-		break;
-	case STYLE_TREE:
-		renderer = unique_ptr<IBSONRenderer>(new BSONObjectTypeDump(params, docPrefixString));
-		break;
-	case STYLE_JSON:
-	case STYLE_JSONPACKED:
-		renderer = unique_ptr<IBSONRenderer>(new JSONDump(params, "  "));
-		break;
-	default:
-		throw std::logic_error("ISE: Undefined STYLE!");
-		break;
+	if (params.getOutputs().empty()) {
+		sink = unique_ptr<OutputSink>(new OutputSink(STDOUT_FILENO, false, params.getBufferSize()));
+		StyleParam style(params.getStyle());
+		// Sampled csv and tsv columns and arrow schemas are collected by one renderer, so its documents are not rendered concurrently.
+		bool sampled = ((style == STYLE_CSV || style == STYLE_TSV) && params.getColumns().empty()) || style == STYLE_ARROW;
+		if (params.getThreads() > 1 && !sampled) { // Render the documents of each batch concurrently, in order.
+			renderer = unique_ptr<IBSONRenderer>(new BSONParallelRenderer(params,
+					[&params, style, &docPrefixString] () { return createRenderer(params, style, docPrefixString); }));
+		} else {
+			renderer = unique_ptr<IBSONRenderer>(createRenderer(params, params.getStyle(), docPrefixString));
+		}
+		renderer->setOutputSink(*sink);
+	} else { // Fan each document out to every --output style.
+		BSONCompositeRenderer* composite = new BSONCompositeRenderer(params);
+		renderer = unique_ptr<IBSONRenderer>(composite);
+		for (const OutputParam& o : params.getOutputs()) { // Parameters allows each file, and the standard output, once.
+			IBSONRenderer* r = createRenderer(params, o.style, docPrefixString);
+			if (o.path == "-") {
+				composite->add(r, new OutputSink(STDOUT_FILENO, false, params.getBufferSize()));
+			} else {
+				int fd = ::open(o.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+				if (fd < 0) {
+					delete r;
+					throw std::invalid_argument(string("Cannot open output file: ") + o.path);
+				}
+				composite->add(r, new OutputSink(fd, true, params.getBufferSize()));
+			}
+		}
 	}
 	if (renderer) {
-		renderer->setOutputStream(cout);
 		renderer->begin(NULL);
 		int documentIndex = 0;
-		while (cursor->more()) {
-			const BSONObj& o = cursor->next(); // Get the BSON Object
-			renderer->render(o, documentIndex++, documentCount);
+		vector<BSONObj> batch;
+		auto renderBatch = [&] () {
+			if (!batch.empty()) {
+				renderer->renderBatch(&batch[0], batch.size(), documentIndex, documentCount);
+				documentIndex += batch.size();
+				batch.clear();
+			}
+		};
+		if (params.getCacheDir().empty()) {
+			unique_ptr<DBClientCursor> cursor = c.query(params.getDbCollection(), BSONObj());
+			while (cursor->more()) {
+				do { // The documents of a cursor batch remain valid until the next batch is fetched.
+					batch.push_back(cursor->next());
+				} while (cursor->moreInCurrentBatch());
+				renderBatch();
+			}
+		} else {
+			// The count and the greatest _id identify the collection's state cheaply, without scanning it.
+			BSONObjBuilder idOnly;
+			idOnly.append("_id", 1);
+			BSONObj idFields(idOnly.obj());
+			BSONObj maxIdObject(c.findOne(params.getDbCollection(), Query().sort("_id", -1), &idFields));
+			BSONElement maxId(maxIdObject.getField("_id"));
+			BSONScanCache cache(params.getCacheDir(), hostPort + "/" + params.getDbCollection() + "/{}/{}");
+			if (cache.open(documentCount, maxId)) {
+				if (params.isDebug()) {
+					renderer->flush();
+					cout << "{ cache: \"" << cache.getPath() << "\" }\n" << flush;
+				}
+				const size_t CACHE_BATCH_SIZE = 256;
+				BSONValidator validator;
+				bool trusted = params.isTrusted();
+				while (cache.more()) {
+					BSONObj o(cache.next());
+					if (!trusted && !validator.validate(o.objdata(), o.objsize())) {
+						throw std::runtime_error(string("Invalid document ") + to_string(documentIndex + batch.size()) + " at offset "
+								+ to_string(validator.getErrorOffset()) + " in cache file " + cache.getPath() + ": " + validator.getError());
+					}
+					batch.push_back(o);
+					if (batch.size() == CACHE_BATCH_SIZE) {
+						renderBatch();
+					}
+				}
+				renderBatch();
+			} else {
+				cache.create(documentCount, maxId);
+				unique_ptr<DBClientCursor> cursor = c.query(params.getDbCollection(), BSONObj());
+				while (cursor->more()) {
+					do {
+						batch.push_back(cursor->next());
+						cache.append(batch.back());
+					} while (cursor->moreInCurrentBatch());
+					renderBatch();
+				}
+				cache.commit();
+			}
 		}
 		renderer->end(NULL);
+		renderer->flush();
 	} else {
 		throw std::logic_error("ISE: Undefined renderer!");
 	}
@@ -209,6 +347,9 @@ int main(int argc, char* argv[]) {
 	} catch (std::logic_error &e) {
 		cerr << "mongotype Generic Error: \"" << e.what() << "\"" << endl;
 		exit(2);
+	} catch (std::runtime_error &e) {
+		cerr << "mongotype I/O Error: \"" << e.what() << "\"" << endl;
+		exit(2);
 	}
 	return EXIT_SUCCESS;
 }